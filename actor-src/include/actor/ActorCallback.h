@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace uranus::actor {
+
+    class BaseActor;
+
+    /**
+     * 只能移动的Actor回调
+     * 不超过kInlineSize字节且可无异常移动的可调用对象直接存放在内部缓冲区, 不分配堆内存
+     * 移动时只搬迁内部缓冲区, 大对象则只搬迁指针
+     */
+    class ActorCallback final {
+
+        struct Operations {
+            void (*invoke)(void *, BaseActor *);
+            void (*relocate)(void *dst, void *src) noexcept;
+            void (*destroy)(void *) noexcept;
+        };
+
+    public:
+        static constexpr std::size_t kInlineSize = 4 * sizeof(void *);
+
+        ActorCallback() noexcept
+            : ops_(nullptr) {
+        }
+
+        ActorCallback(std::nullptr_t) noexcept
+            : ops_(nullptr) {
+        }
+
+        template<class F>
+        requires (!std::is_same_v<std::decay_t<F>, ActorCallback>) && std::is_invocable_v<std::decay_t<F> &, BaseActor *>
+        ActorCallback(F &&func)
+            : ops_(nullptr) {
+            using Functor = std::decay_t<F>;
+
+            if constexpr (kIsInline<Functor>) {
+                ::new (static_cast<void *>(storage_)) Functor(std::forward<F>(func));
+                ops_ = &kInlineOps<Functor>;
+            } else {
+                ::new (static_cast<void *>(storage_)) Functor *(new Functor(std::forward<F>(func)));
+                ops_ = &kHeapOps<Functor>;
+            }
+        }
+
+        ~ActorCallback() {
+            this->reset();
+        }
+
+        ActorCallback(const ActorCallback &) = delete;
+        ActorCallback &operator=(const ActorCallback &) = delete;
+
+        ActorCallback(ActorCallback &&rhs) noexcept
+            : ops_(rhs.ops_) {
+            if (ops_ != nullptr) {
+                ops_->relocate(storage_, rhs.storage_);
+                rhs.ops_ = nullptr;
+            }
+        }
+
+        ActorCallback &operator=(ActorCallback &&rhs) noexcept {
+            if (this != &rhs) {
+                this->reset();
+                ops_ = rhs.ops_;
+                if (ops_ != nullptr) {
+                    ops_->relocate(storage_, rhs.storage_);
+                    rhs.ops_ = nullptr;
+                }
+            }
+            return *this;
+        }
+
+        void operator()(BaseActor *actor) {
+            if (ops_ != nullptr) {
+                ops_->invoke(storage_, actor);
+            }
+        }
+
+        explicit operator bool() const noexcept {
+            return ops_ != nullptr;
+        }
+
+        void reset() noexcept {
+            if (ops_ != nullptr) {
+                ops_->destroy(storage_);
+                ops_ = nullptr;
+            }
+        }
+
+    private:
+        template<class Functor>
+        static constexpr bool kIsInline =
+            sizeof(Functor) <= kInlineSize &&
+            alignof(Functor) <= alignof(void *) &&
+            std::is_nothrow_move_constructible_v<Functor>;
+
+        template<class Functor>
+        static constexpr Operations kInlineOps = {
+            [](void *ptr, BaseActor *actor) {
+                (*static_cast<Functor *>(ptr))(actor);
+            },
+            [](void *dst, void *src) noexcept {
+                auto *from = static_cast<Functor *>(src);
+                ::new (dst) Functor(std::move(*from));
+                from->~Functor();
+            },
+            [](void *ptr) noexcept {
+                static_cast<Functor *>(ptr)->~Functor();
+            }
+        };
+
+        template<class Functor>
+        static constexpr Operations kHeapOps = {
+            [](void *ptr, BaseActor *actor) {
+                (**static_cast<Functor **>(ptr))(actor);
+            },
+            [](void *dst, void *src) noexcept {
+                ::new (dst) Functor *(*static_cast<Functor **>(src));
+            },
+            [](void *ptr) noexcept {
+                delete *static_cast<Functor **>(ptr);
+            }
+        };
+
+    private:
+        alignas(void *) std::byte storage_[kInlineSize];
+        const Operations *ops_;
+    };
+}
@@ -2,6 +2,7 @@
 
 #include "Package.h"
 #include "DataAsset.h"
+#include "ActorRef.h"
 
 #include <base/noncopy.h>
 #include <asio/any_completion_handler.hpp>
@@ -10,6 +11,7 @@
 #include <functional>
 #include <chrono>
 #include <map>
+#include <set>
 #include <string>
 
 
@@ -35,6 +37,16 @@ namespace uranus::actor {
     using SessionHandler    = asio::any_completion_handler<void(PackageHandle)>;
     using CommandHandler    = asio::any_completion_handler<void(DataAssetHandle)>;
 
+    /// 异步请求的调用选项
+    struct CallOptions {
+        /// 截止时间, 为空时使用会话的默认超时; 截止时间随请求一同送达被调用方
+        SteadyTimePoint deadline{};
+
+        static CallOptions timeout(const SteadyDuration d) {
+            return { std::chrono::steady_clock::now() + d };
+        }
+    };
+
 
     class ACTOR_API ActorContext {
 
@@ -58,11 +70,24 @@ namespace uranus::actor {
         [[nodiscard]] virtual ActorMap getActorMap(const string &type) const = 0;
         [[nodiscard]] virtual int64_t queryActorId(const string &type, const string &name) const = 0;
 
+        /// 解析一次后缓存, 之后通过send(ActorRef)发送时不再查表; ty为Package::kToService或kToPlayer
+        [[nodiscard]] virtual ActorRef resolve(int ty, int64_t target) const = 0;
+        [[nodiscard]] ActorRef resolve(const string &type, const string &name) const;
+
         virtual void send(int ty, int64_t target, PackageHandle &&pkg) = 0;
 
+        /// 直接投递到已解析的目标, 目标失效时丢弃
+        virtual void send(const ActorRef &ref, PackageHandle &&pkg) = 0;
+
+        /// 向多个目标发送同一个Package, 载荷只共享不复制
+        virtual void multicast(int ty, const std::set<int64_t> &targets, PackageHandle &&pkg) = 0;
+
         template<asio::completion_token_for<void(PackageHandle)> CompletionToken>
         auto call(int ty, int64_t target, PackageHandle &&req, CompletionToken &&token = asio::use_awaitable);
 
+        template<asio::completion_token_for<void(PackageHandle)> CompletionToken = asio::use_awaitable_t<>>
+        auto call(int ty, int64_t target, PackageHandle &&req, const CallOptions &opts, CompletionToken &&token = asio::use_awaitable);
+
         virtual void listen(int64_t evt, bool cancel) = 0;
         virtual void dispatch(int64_t evt, DataAssetHandle &&data) = 0;
 
@@ -75,7 +100,7 @@ namespace uranus::actor {
         auto sendCommand(const string &cmd, DataAssetHandle &&data, CompletionToken &&token = asio::use_awaitable);
 
     protected:
-        virtual void createSession(int ty, int64_t target, PackageHandle &&req, SessionHandler &&handle) = 0;
+        virtual void createSession(int ty, int64_t target, PackageHandle &&req, SteadyTimePoint deadline, SessionHandler &&handle) = 0;
         virtual void createCommand(const string &cmd, DataAssetHandle &&data, CommandHandler &&handler) = 0;
     };
 
@@ -90,14 +115,20 @@ namespace uranus::actor {
 
     template<asio::completion_token_for<void(PackageHandle)> CompletionToken>
     auto ActorContext::call(int ty, int64_t target, PackageHandle &&req, CompletionToken &&token) {
+        return this->call(ty, target, std::move(req), CallOptions{}, std::forward<CompletionToken>(token));
+    }
+
+    template<asio::completion_token_for<void(PackageHandle)> CompletionToken>
+    auto ActorContext::call(int ty, int64_t target, PackageHandle &&req, const CallOptions &opts, CompletionToken &&token) {
         return asio::async_initiate<CompletionToken, void(PackageHandle)>([this](
             asio::completion_handler_for<void(PackageHandle)> auto handler,
             const int type,
             const int64_t dest,
-            PackageHandle &&temp
+            PackageHandle &&temp,
+            const SteadyTimePoint deadline
         ) mutable {
-            this->createSession(type, dest, std::move(temp), std::move(handler));
-        }, token, ty, target, std::move(req));
+            this->createSession(type, dest, std::move(temp), deadline, std::move(handler));
+        }, token, ty, target, std::move(req), opts.deadline);
     }
 
     template<asio::completion_token_for<void(DataAssetHandle)> CompletionToken>
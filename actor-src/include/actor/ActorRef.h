@@ -0,0 +1,48 @@
+#pragma once
+
+#include "actor.export.h"
+
+#include <cstdint>
+#include <memory>
+
+
+namespace uranus::actor {
+
+    class BaseActorContext;
+
+    /**
+     * 解析后的Actor地址
+     * 由ActorContext::resolve()创建, 发送时直接投递到目标邮箱, 不再按名字或id查表;
+     * 只持有目标的弱引用, 目标停止后失效, 调用者应重新解析
+     */
+    class ACTOR_API ActorRef final {
+
+    public:
+        ActorRef();
+        ActorRef(int type, int64_t id, const std::weak_ptr<BaseActorContext> &target);
+        ~ActorRef();
+
+        ActorRef(const ActorRef &rhs);
+        ActorRef &operator=(const ActorRef &rhs);
+
+        ActorRef(ActorRef &&rhs) noexcept;
+        ActorRef &operator=(ActorRef &&rhs) noexcept;
+
+        /// Package::kToService或Package::kToPlayer
+        [[nodiscard]] int getType() const;
+        [[nodiscard]] int64_t getId() const;
+
+        /// 目标仍在运行
+        [[nodiscard]] bool isValid() const;
+        explicit operator bool() const;
+
+        [[nodiscard]] std::shared_ptr<BaseActorContext> lock() const;
+
+        void reset();
+
+    private:
+        int type_;
+        int64_t id_;
+        std::weak_ptr<BaseActorContext> target_;
+    };
+}
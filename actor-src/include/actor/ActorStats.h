@@ -0,0 +1,70 @@
+#pragma once
+
+#include "actor.export.h"
+#include "Envelope.h"
+
+#include <base/noncopy.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+namespace uranus::actor {
+
+    /// 某一时刻的统计数据, 时间单位均为纳秒, 下标为Envelope::EnvelopeType
+    struct ActorStatsSnapshot {
+        static constexpr size_t kTypeCount = Envelope::kTypeEnd;
+        static_assert(kTypeCount > Envelope::kSharedEvent, "every envelope type needs a stats slot");
+
+        std::array<uint64_t, kTypeCount> messages{};
+        std::array<uint64_t, kTypeCount> handleTime{};
+
+        /// 信封在邮箱中等待的总时间及最大值
+        uint64_t waitTime = 0;
+        uint64_t maxWait = 0;
+
+        /// 邮箱的峰值深度
+        size_t peakDepth = 0;
+
+        [[nodiscard]] uint64_t totalMessages() const;
+        [[nodiscard]] uint64_t totalHandleTime() const;
+    };
+
+    /// Actor id及其统计, 用于排行查询
+    using ActorStatsRank = std::vector<std::pair<int64_t, ActorStatsSnapshot>>;
+
+    /**
+     * 单个Actor的运行统计
+     * 处理相关的计数只在Actor执行器上写入, 任意线程都可以读取快照
+     */
+    class ACTOR_API ActorStats final {
+
+    public:
+        ActorStats();
+        ~ActorStats();
+
+        DISABLE_COPY_MOVE(ActorStats)
+
+        /// 处理完一条信封后记录
+        void record(int type, SteadyDuration handle, SteadyDuration wait);
+
+        /// 生产者投递后记录当前邮箱深度
+        void observeDepth(size_t depth);
+
+        [[nodiscard]] ActorStatsSnapshot snapshot() const;
+
+        /// 清零, 用于按时间窗口统计
+        void reset();
+
+    private:
+        std::array<std::atomic<uint64_t>, ActorStatsSnapshot::kTypeCount> messages_;
+        std::array<std::atomic<uint64_t>, ActorStatsSnapshot::kTypeCount> handleTime_;
+
+        std::atomic<uint64_t> waitTime_;
+        std::atomic<uint64_t> maxWait_;
+        std::atomic<size_t> peakDepth_;
+    };
+}
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "Package.h"
+#include "mailbox/ActorMailbox.h"
 #include "base/noncopy.h"
 
+#include <asio/awaitable.hpp>
 #include <chrono>
 
 namespace uranus::actor {
@@ -16,6 +18,8 @@ namespace uranus::actor {
     using SteadyDuration = std::chrono::steady_clock::duration;
     using DataAssetHandle = std::unique_ptr<DataAsset>;
 
+    using asio::awaitable;
+
     class ACTOR_API BaseActor {
 
         friend class BaseActorContext;
@@ -34,22 +38,69 @@ namespace uranus::actor {
         virtual void onTerminate();
 
         virtual void onPackage(int64_t src, PackageHandle &&pkg) = 0;
+
+        /// 多播的只读Package, 默认复制一份后交给onPackage
+        /// 默认实现对每个接收者都复制一次, 需要重写并直接读取共享的Package才能省去复制
+        virtual void onMulticast(int64_t src, const SharedPackage &pkg);
         virtual void onEvent(int64_t evt, DataAsset *data) = 0;
 
+        /// 多个监听者共享的只读事件数据, 默认复制一份后交给onEvent
+        /// 与onMulticast相同, 只有重写此函数的监听者才能省去clone()
+        virtual void onEvent(int64_t evt, const DataAsset *data);
+
         virtual PackageHandle onRequest(int64_t src, PackageHandle &&req) = 0;
 
+        /// 协程版本的请求处理, asyncRequest_为true时在Actor执行器上启动
+        /// 挂起期间邮箱中的其他消息照常处理, 协程结束后发送响应
+        virtual awaitable<PackageHandle> onRequestAsync(int64_t src, PackageHandle req, SteadyTimePoint deadline);
+
         virtual void onTick(SteadyTimePoint now, SteadyDuration delta);
 
         ServerModule *getModule(const std::string &name) const;
 
+        /// 当前处理中请求的截止时间, 不在onRequest中或调用方未指定时为空
+        [[nodiscard]] SteadyTimePoint getRequestDeadline() const;
+
+        /// 当前请求的剩余预算, 未指定截止时间时返回SteadyDuration::max()
+        [[nodiscard]] SteadyDuration getRemainingBudget() const;
+
     private:
+        /// 在作用域内设置当前请求的截止时间, 离开时清除, onRequest()抛出异常时同样清除
+        struct DeadlineScope {
+            SteadyTimePoint &deadline;
+
+            DeadlineScope(SteadyTimePoint &target, SteadyTimePoint value);
+            ~DeadlineScope();
+
+            DISABLE_COPY_MOVE(DeadlineScope)
+        };
+
         ActorContext *ctx_;
+        SteadyTimePoint requestDeadline_;
 
     protected:
         bool enableTick_;
+
+        /// 为true时请求交由onRequestAsync处理
+        bool asyncRequest_;
+
+        /// Tick周期, 相同周期的Actor共享TickService的分片定时器
+        SteadyDuration tickPeriod_;
+
+        /// 每次唤醒后最多连续处理的信封数量, 1表示逐条处理
+        size_t mailboxBatch_;
+
+        /// 邮箱容量及超出容量时的处理策略
+        size_t mailboxCapacity_;
+        MailboxPolicy mailboxPolicy_;
+
+        /// 邮箱背压的高低水位, 高水位为0表示不启用
+        size_t mailboxHighWatermark_;
+        size_t mailboxLowWatermark_;
     };
 
-    inline constexpr auto kUranusActorABIVersion = 1;
+    /// BaseActor的成员布局或虚函数表变化时加一, 旧版本头文件编译的插件会被工厂拒绝加载
+    inline constexpr auto kUranusActorABIVersion = 2;
     inline constexpr auto kUranusActorAPIVersion = 1;
     inline constexpr auto kUranusActorHeaderVersion = 1;
 
@@ -2,7 +2,11 @@
 
 #include "ActorContext.h"
 #include "Envelope.h"
+#include "ActorStats.h"
+#include "mailbox/ActorMailbox.h"
 #include "timer/TimerManager.h"
+#include "timer/TickService.h"
+#include "timer/TimerService.h"
 #include "session/SessionManager.h"
 
 #include <base/AttributeMap.h>
@@ -23,7 +27,8 @@ namespace uranus::actor {
     class ACTOR_API BaseActorContext : public ActorContext, public std::enable_shared_from_this<BaseActorContext> {
 
         friend class RepeatedTimer;
-        friend class RequestSession;
+        friend class TimerManager;
+        friend class TimingWheel;
 
     public:
         BaseActorContext() = delete;
@@ -53,17 +58,40 @@ namespace uranus::actor {
 
         void pushEnvelope(Envelope &&envelope);
 
+        /// 邮箱超过高水位时返回true, 调用者应暂停投递直到onMailboxRelieved()
+        bool checkCongestion();
+
+        /// 单次调度最多处理的信封数量, 达到后让出工作线程
+        void setQuota(size_t quota);
+        [[nodiscard]] size_t getQuota() const;
+
+        /// 各类信封的处理数量和耗时, 邮箱等待时间及峰值深度
+        [[nodiscard]] ActorStats &getStats();
+        [[nodiscard]] const ActorStats &getStats() const;
+
+        /// 玩家id或服务id, 用于日志和监控
+        [[nodiscard]] int64_t getActorId() const;
+
         RepeatedTimerHandle createTimer(const RepeatedTask &task, SteadyDuration delay, SteadyDuration rate) override;
         RepeatedTimerHandle createTimer(const RepeatedTask &task, SteadyTimePoint point, SteadyDuration rate) override;
 
         void cancelTimer(const RepeatedTimerHandle &handle) override;
 
     protected:
-        void createSession(int ty, int64_t target, PackageHandle &&req, SessionHandler &&handle) override;
+        void createSession(int ty, int64_t target, PackageHandle &&req, SteadyTimePoint deadline, SessionHandler &&handle) override;
 
-        virtual void sendRequest(int ty, int64_t sess, int64_t target, PackageHandle &&pkg) = 0;
+        virtual void sendRequest(int ty, int64_t sess, int64_t target, PackageHandle &&pkg, SteadyTimePoint deadline) = 0;
         virtual void sendResponse(int ty, int64_t sess, int64_t target, PackageHandle &&pkg) = 0;
 
+        /// 共享的Tick服务, 返回nullptr时Actor使用自己的定时器
+        [[nodiscard]] virtual TickService *getTickService() const;
+
+        /// 共享的时间轮, 返回nullptr时每个定时器使用自己的SteadyTimer
+        [[nodiscard]] virtual TimerService *getTimerService() const;
+
+        /// 拥塞的邮箱降到低水位, 在Actor执行器上调用
+        virtual void onMailboxRelieved();
+
         virtual void onErrorCode(std::error_code ec);
         virtual void onException(std::exception &e);
 
@@ -72,10 +100,16 @@ namespace uranus::actor {
         SessionManager &getSessionManager();
         TimerManager &getTimerManager();
 
+        void setActorId(int64_t id);
+
     private:
-        awaitable<void> process();
+        void drain();
         awaitable<void> tick();
 
+        awaitable<void> processRequest(int ty, int64_t sess, int64_t from, PackageHandle req, SteadyTimePoint deadline);
+
+        void dispatchEnvelope(Envelope &&evl);
+
     private:
         asio::any_io_executor exec_;
 
@@ -85,8 +119,14 @@ namespace uranus::actor {
         atomic_flag running_;
         atomic_flag terminated_;
 
-        ConcurrentChannel<Envelope> mailbox_;
+        ActorMailbox mailbox_;
+        size_t quota_;
+
+        ActorStats stats_;
+        std::atomic<int64_t> actorId_;
+
         SteadyTimer ticker_;
+        TickService *tickService_;
 
         SessionManager sessionManager_;
         TimerManager timerManager_;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "BaseActor.h"
+#include "ActorRef.h"
 
 
 namespace uranus::actor {
@@ -13,6 +14,10 @@ namespace uranus::actor {
 
         void sendToClient(PackageHandle &&pkg) const;
         void sendToService(const std::string &name, PackageHandle &&pkg) const;
+
+        /// 解析服务地址, 高频发送时缓存返回值并使用下面的重载
+        [[nodiscard]] ActorRef resolveService(const std::string &name) const;
+        void sendToService(const ActorRef &ref, PackageHandle &&pkg) const;
     };
 }
 
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "BaseActor.h"
+#include "ActorRef.h"
+
+#include <set>
 
 namespace uranus::actor {
 
@@ -13,8 +16,14 @@ namespace uranus::actor {
         [[nodiscard]] virtual std::string getName() const = 0;
 
         void sendToClient(PackageHandle &&pkg) const;
+        void sendToClients(const std::set<int64_t> &pids, PackageHandle &&pkg) const;
         void sendToPlayer(int64_t pid, PackageHandle &&pkg) const;
+        void sendToPlayers(const std::set<int64_t> &pids, PackageHandle &&pkg) const;
         void sendToService(const std::string &name, PackageHandle &&pkg) const;
+
+        /// 解析服务地址, 高频发送时缓存返回值并使用下面的重载
+        [[nodiscard]] ActorRef resolveService(const std::string &name) const;
+        void sendToService(const ActorRef &ref, PackageHandle &&pkg) const;
     };
 }
 
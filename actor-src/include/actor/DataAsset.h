@@ -2,6 +2,8 @@
 
 #include "actor.export.h"
 
+#include <memory>
+
 namespace uranus::actor {
 
     class ACTOR_API DataAsset {
@@ -10,6 +12,9 @@ namespace uranus::actor {
         DataAsset();
         virtual ~DataAsset();
 
-        virtual DataAsset *clone() = 0;
+        virtual DataAsset *clone() const = 0;
     };
+
+    /// 事件分发时所有监听者共享同一份只读数据, 需要修改时先clone()
+    using SharedDataAsset = std::shared_ptr<const DataAsset>;
 }
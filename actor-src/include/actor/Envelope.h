@@ -2,16 +2,13 @@
 
 #include "Package.h"
 #include "DataAsset.h"
+#include "ActorCallback.h"
 
-#include <variant>
 #include <chrono>
-#include <functional>
 
 
 namespace uranus::actor {
 
-    class BaseActor;
-
     using DataAssetHandle = std::unique_ptr<DataAsset>;
     using SteadyTimePoint = std::chrono::steady_clock::time_point;
     using SteadyDuration = std::chrono::steady_clock::duration;
@@ -21,8 +18,10 @@ namespace uranus::actor {
         SteadyDuration delta;
     };
 
-    using ActorCallback = std::function<void(BaseActor *)>;
-
+    /**
+     * 以type作为标签的紧凑信封, 载荷按类型存放在同一块联合体中
+     * 移动时只复制头部字段并搬迁当前载荷, 不经过std::variant
+     */
     struct ACTOR_API Envelope final {
 
         enum EnvelopeType {
@@ -31,14 +30,13 @@ namespace uranus::actor {
             kResponse   = 3,
             kDataAsset  = 4,
             kTickInfo   = 5,
-            kCallback   = 6
-        };
+            kCallback   = 6,
+            kMulticast  = 7,
+            kSharedEvent = 8,
 
-        using VariantHandle = std::variant<
-            PackageHandle,
-            DataAssetHandle,
-            ActorTickInfo,
-            ActorCallback>;
+            // 新类型加在这一项之前, ActorStats按它确定统计数组的大小
+            kTypeEnd
+        };
 
         int32_t type;
         int32_t flag;
@@ -50,9 +48,11 @@ namespace uranus::actor {
             int64_t event;
         };
 
-        VariantHandle variant;
+        /// 请求的截止时间, 为空表示调用方未指定
+        SteadyTimePoint deadline;
 
         Envelope();
+        ~Envelope();
 
         Envelope(const Envelope &) = delete;
         Envelope &operator=(const Envelope &) = delete;
@@ -60,13 +60,44 @@ namespace uranus::actor {
         Envelope(Envelope &&rhs) noexcept;
         Envelope &operator=(Envelope &&rhs) noexcept;
 
+        /// 类型不匹配时返回nullptr
+        [[nodiscard]] PackageHandle *getPackage();
+        [[nodiscard]] SharedPackage *getSharedPackage();
+        [[nodiscard]] DataAssetHandle *getDataAsset();
+        [[nodiscard]] SharedDataAsset *getSharedDataAsset();
+        [[nodiscard]] ActorTickInfo *getTickInfo();
+        [[nodiscard]] ActorCallback *getCallback();
+
+        /// 释放载荷并回到空信封
+        void reset() noexcept;
+
         static Envelope makePackage(int flag, int64_t src, PackageHandle &&pkg);
 
-        static Envelope makeRequest(int flag, int64_t src, int64_t sess, PackageHandle &&req);
+        static Envelope makeRequest(int flag, int64_t src, int64_t sess, PackageHandle &&req, SteadyTimePoint deadline = {});
         static Envelope makeResponse(int flag, int64_t src, int64_t sess, PackageHandle &&res);
 
+        /// 同一个SharedPackage可以投递到任意多个邮箱
+        static Envelope makeMulticast(int flag, int64_t src, const SharedPackage &pkg);
+
         static Envelope makeDataAsset(int64_t evt, DataAssetHandle &&data);
+
+        /// 同一个SharedDataAsset可以投递到任意多个邮箱
+        static Envelope makeSharedEvent(int64_t evt, const SharedDataAsset &data);
+
         static Envelope makeTickInfo(SteadyTimePoint now, SteadyDuration delta);
-        static Envelope makeCallback(const ActorCallback &cb);
+        static Envelope makeCallback(ActorCallback &&cb);
+
+    private:
+        void relocate(Envelope &rhs) noexcept;
+
+    private:
+        union {
+            PackageHandle package_;
+            SharedPackage sharedPackage_;
+            DataAssetHandle dataAsset_;
+            SharedDataAsset sharedDataAsset_;
+            ActorTickInfo tickInfo_;
+            ActorCallback callback_;
+        };
     };
-}
\ No newline at end of file
+}
@@ -4,6 +4,7 @@
 
 #include <base/Message.h>
 #include <base/Recycler.h>
+#include <memory>
 #include <vector>
 
 
@@ -19,7 +20,7 @@ namespace uranus::actor {
         };
 
         template<typename T>
-        class BufferAllocator final {
+        class BufferAllocator {
         public:
             using value_type = std::remove_cvref_t<std::remove_pointer_t<std::remove_all_extents_t<T> > >;
 
@@ -38,6 +39,12 @@ namespace uranus::actor {
             void deallocate(T *p, std::size_t) noexcept {
                 BufferHeap::deallocate(p);
             }
+
+            /// 无状态分配器, 任意两个实例都可以互相释放
+            template<class U>
+            bool operator==(const BufferAllocator<U> &) const noexcept {
+                return true;
+            }
         };
     }
 
@@ -69,12 +76,27 @@ namespace uranus::actor {
         void setData(const std::vector<uint8_t> &bytes);
         void setData(const uint8_t *data, size_t length);
 
+        /// 载荷容量不足时从当前线程的分级缓冲池取一块合适的缓冲区, 已有内容时直接扩容
+        void reserve(size_t size);
+
+        /// 常见的小包, 不超过该长度时直接在Package自己的缓冲区上扩容, 不从缓冲池取
+        static constexpr size_t kInlineCapacity = 1024;
+
         [[nodiscard]] std::string toString() const;
 
         void recycle();
 
         void copy(Message &other) const override;
 
+    private:
+        /**
+         * 载荷缓冲区按容量分级缓存在线程本地
+         * 回收时容量小于最小级别的缓冲区留在Package中, 其余按级别放回缓冲池,
+         * 超过最大级别的直接释放, 偶尔出现的大包不会长期占用内存
+         */
+        static ByteArray acquirePayload(size_t size);
+        static void releasePayload(ByteArray &&buffer);
+
     private:
         PackageRecyclerHandle handle_;
 
@@ -84,4 +106,9 @@ namespace uranus::actor {
     };
 
     DECLARE_MESSAGE_POOL(Package)
+
+    /// 只读共享的Package, 可以同时位于多个邮箱中, 最后一个持有者释放时回收
+    using SharedPackage = std::shared_ptr<const Package>;
+
+    ACTOR_API SharedPackage MakeSharedPackage(PackageHandle &&pkg);
 }
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "Package.h"
+#include "PackageFramer.h"
 
 #include <network/MessageCodec.h>
 
@@ -9,6 +9,8 @@ namespace uranus::actor {
 
     using network::MessageCodec;
     using network::BaseConnection;
+    using network::WireBuffer;
+    using network::WriteBatch;
     using asio::awaitable;
     using std::error_code;
     using std::tuple;
@@ -18,40 +20,51 @@ namespace uranus::actor {
     class ACTOR_API PackageCodec final : public MessageCodec<Package> {
 
     public:
-#pragma region Error code
-        enum class ErrorCode {
-            kReadHeaderLength,
-            kReadPayloadLength,
-            kWriteLength,
-        };
-#pragma endregion
+        using ErrorCode = PackageFramer::ErrorCode;
+        using Framing = PackageFramer::Framing;
+        using CompressionOptions = PackageFramer::CompressionOptions;
+
+        static constexpr size_t kMaxHeaderSize = PackageFramer::kMaxHeaderSize;
+        static constexpr size_t kDefaultMaxFrameSize = PackageFramer::kDefaultMaxFrameSize;
+        static constexpr size_t kReadBufferSize = PackageFramer::kReadBufferSize;
 
         explicit PackageCodec(BaseConnection &conn);
         ~PackageCodec() override;
 
         awaitable<error_code> encode(Package *pkg) override;
         awaitable<ResultTuple> decode() override;
-    };
 
-    class ACTOR_API PackageCodecErrorCategory : public std::error_category {
+        bool gather(Package *pkg, WriteBatch &batch) override;
 
-    public:
-        [[nodiscard]] constexpr const char *name() const noexcept override {
-            return "PackageCodecErrorCategory";
-        }
+        /// 编码为完整的帧, 广播时每种格式只编码一次, 由所有连接共享
+        [[nodiscard]] static WireBuffer serialize(const Package &pkg, Framing framing = Framing::kFixed);
 
-        [[nodiscard]] std::string message(int val) const override;
+        /// 只能在socket执行器上调用, 读写格式分开切换, 由连接决定切换的时机
+        void setReadFraming(Framing framing);
+        void setWriteFraming(Framing framing);
 
-         static const std::error_category &get() noexcept {
-            static PackageCodecErrorCategory _inst;
-            return _inst;
-        }
-    };
+        [[nodiscard]] Framing getReadFraming() const;
+        [[nodiscard]] Framing getWriteFraming() const;
 
-    inline std::error_code make_error_code(PackageCodec::ErrorCode ec) noexcept {
-        return { static_cast<int>(ec), PackageCodecErrorCategory::get() };
-    }
-}
+        /// 同时限制解压后的长度, 须在connect()之前设置
+        void setMaxFrameSize(size_t size);
+        [[nodiscard]] size_t getMaxFrameSize() const;
+
+        /// 须在connect()之前设置
+        void setCompressionOptions(const CompressionOptions &options);
 
-template<>
-struct std::is_error_code_enum<uranus::actor::PackageCodec::ErrorCode> : true_type {};
+        /// 只能在socket执行器上调用, 与帧格式一样在登录时协商, 分别切换
+        void setReadCompression(bool enable);
+        void setWriteCompression(bool enable);
+
+        [[nodiscard]] bool getReadCompression() const;
+        [[nodiscard]] bool getWriteCompression() const;
+
+    private:
+        // 分帧和压缩的状态, 不涉及socket
+        PackageFramer framer_;
+
+        // 只在读循环中访问, 超过读缓冲区的压缩载荷
+        std::vector<uint8_t> compressed_;
+    };
+}
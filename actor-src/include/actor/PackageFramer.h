@@ -0,0 +1,175 @@
+#pragma once
+
+#include "Package.h"
+
+#include <base/noncopy.h>
+#include <asio/buffer.hpp>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+
+namespace uranus::actor {
+
+    using std::error_code;
+
+    /**
+     * 不依赖socket的帧编解码核心, PackageCodec只负责读写socket
+     * 头部的编解码, 读缓冲区中的分帧, 以及连接独立的deflate流都在这里, 只在所属连接的读写循环中访问
+     */
+    class ACTOR_API PackageFramer final {
+
+    public:
+#pragma region Error code
+        enum class ErrorCode {
+            kReadHeaderLength,
+            kReadPayloadLength,
+            kWriteLength,
+            kMalformedHeader,
+            kCompress,
+            kDecompress,
+            kFrameTooLarge,
+        };
+#pragma endregion
+
+        /**
+         * 帧格式
+         * kFixed: 大端的int64 id和uint64长度, 共16字节, 默认格式; 长度的最高位为压缩标记
+         * kCompact: varint编码的id和长度, 小id的短包头部只有2~4字节, 登录时协商启用; 长度左移一位, 最低位为压缩标记
+         */
+        enum class Framing : uint8_t {
+            kFixed,
+            kCompact,
+        };
+
+        /// 解析后的头部
+        struct FrameHeader {
+            int64_t id = 0;
+            size_t length = 0;
+            bool compressed = false;
+        };
+
+        /// 任意格式头部的最大长度
+        static constexpr size_t kMaxHeaderSize = 20;
+
+        /// 默认的最大载荷长度, 头部声明的长度超过时在分配内存之前断开
+        static constexpr size_t kDefaultMaxFrameSize = 4 * 1024 * 1024;
+
+        /// 读缓冲区的初始大小, 超过该大小的载荷直接读入Package
+        static constexpr size_t kReadBufferSize = 8192;
+
+        /**
+         * 载荷压缩参数
+         * 超过阈值的载荷用连接独立的raw deflate流压缩, 每条消息以Z_SYNC_FLUSH结束,
+         * 字典跨消息保留, 重复的protobuf结构后续压缩得更小
+         */
+        struct CompressionOptions {
+            size_t threshold;
+            int level;
+
+            /// deflate窗口位数, 9~15, 越小每个连接占用的内存越少
+            int window;
+        };
+
+        PackageFramer();
+        ~PackageFramer();
+
+        DISABLE_COPY_MOVE(PackageFramer)
+
+        /// 编码头部到out, 返回头部长度, out至少有kMaxHeaderSize字节
+        static size_t writeHeader(Framing framing, int64_t id, size_t length, bool compressed, uint8_t *out);
+
+        /// 从[data, data + available)解析头部, 返回头部长度, 数据不完整时返回0; 头部格式错误时设置ec
+        static size_t readHeader(Framing framing, const uint8_t *data, size_t available, FrameHeader &header, error_code &ec);
+
+        void setReadFraming(Framing framing);
+        void setWriteFraming(Framing framing);
+
+        [[nodiscard]] Framing getReadFraming() const;
+        [[nodiscard]] Framing getWriteFraming() const;
+
+        /// 同时限制解压后的长度
+        void setMaxFrameSize(size_t size);
+        [[nodiscard]] size_t getMaxFrameSize() const;
+
+        /// 须在第一次压缩之前设置
+        void setCompressionOptions(const CompressionOptions &options);
+
+        void setReadCompression(bool enable);
+        void setWriteCompression(bool enable);
+
+        [[nodiscard]] bool getReadCompression() const;
+        [[nodiscard]] bool getWriteCompression() const;
+
+        /// 压缩到deflated(), 未启用或低于阈值时返回false; 失败时设置ec
+        bool deflatePayload(const Package &pkg, error_code &ec);
+
+        /// 上一次deflatePayload()的结果, 下一次压缩时被覆盖
+        [[nodiscard]] const std::vector<uint8_t> &deflated() const;
+
+        /// 解压到pkg的载荷, 超过最大帧长度时返回kFrameTooLarge
+        error_code inflatePayload(const uint8_t *data, size_t size, Package &pkg);
+
+        /// 读缓冲区的空闲部分, 未解析的数据先移到开头
+        asio::mutable_buffer prepare();
+
+        /// prepare()返回的区域中写入了size字节
+        void commit(size_t size);
+
+        /// 读缓冲区中已有完整的包时直接解析; 头部格式错误或长度超过限制时设置ec
+        PackageHandle parse(error_code &ec);
+
+        /// 头部已经完整, 但整帧放不进读缓冲区时返回头部长度, 否则返回0
+        size_t oversized(FrameHeader &header) const;
+
+        /// 把头部之后已经缓冲的载荷复制到target并清空读缓冲区, 返回复制的字节数
+        size_t drain(size_t headerSize, uint8_t *target);
+
+    private:
+        class Deflater;
+        class Inflater;
+
+        Framing readFraming_;
+        Framing writeFraming_;
+
+        size_t maxFrameSize_;
+
+        CompressionOptions compression_;
+        bool readCompression_;
+        bool writeCompression_;
+
+        // 第一次用到时才创建, 不压缩的连接不占用zlib的内存
+        std::unique_ptr<Deflater> deflater_;
+        std::unique_ptr<Inflater> inflater_;
+
+        // 只在写循环中访问, 压缩后的载荷
+        std::vector<uint8_t> deflated_;
+
+        // 只在读循环中访问, [readHead_, readTail_)为未解析的数据
+        std::vector<uint8_t> readBuffer_;
+        size_t readHead_;
+        size_t readTail_;
+    };
+
+    class ACTOR_API PackageCodecErrorCategory : public std::error_category {
+
+    public:
+        [[nodiscard]] constexpr const char *name() const noexcept override {
+            return "PackageCodecErrorCategory";
+        }
+
+        [[nodiscard]] std::string message(int val) const override;
+
+         static const std::error_category &get() noexcept {
+            static PackageCodecErrorCategory _inst;
+            return _inst;
+        }
+    };
+
+    inline std::error_code make_error_code(PackageFramer::ErrorCode ec) noexcept {
+        return { static_cast<int>(ec), PackageCodecErrorCategory::get() };
+    }
+}
+
+template<>
+struct std::is_error_code_enum<uranus::actor::PackageFramer::ErrorCode> : true_type {};
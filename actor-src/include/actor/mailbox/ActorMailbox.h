@@ -0,0 +1,157 @@
+#pragma once
+
+#include "actor/Envelope.h"
+
+#include <base/noncopy.h>
+#include <base/Recycler.h>
+#include <atomic>
+
+
+namespace uranus::actor {
+
+    enum class MailboxPolicy {
+        kGrow,          // 不限制容量
+        kDropOldest,    // 取出时丢弃超出容量的最早的信封; 消费者停滞时积压达到kDropOldestSlack倍容量后新信封也被丢弃
+        kReject,        // 超出容量时拒绝新的信封
+    };
+
+    /// 邮箱链表节点, 从线程本地的回收池中获取, 处理完后归还
+    class ACTOR_API MailboxNode final {
+
+        DECLARE_RECYCLER_GET(MailboxNode)
+
+        explicit MailboxNode(const MailboxNodeRecyclerHandle &handle);
+
+    public:
+        /// 不属于回收池的节点, 用作队列的哨兵
+        MailboxNode();
+        ~MailboxNode();
+
+        DISABLE_COPY_MOVE(MailboxNode)
+
+        void recycle();
+
+        std::atomic<MailboxNode *> next;
+        Envelope value;
+
+        /// 进入邮箱的时间
+        SteadyTimePoint enqueued;
+
+    private:
+        MailboxNodeRecyclerHandle handle_;
+    };
+
+    DECLARE_RECYCLER(MailboxNode)
+
+    /**
+     * 多生产者单消费者的无锁邮箱
+     * 生产者只在邮箱从空闲变为繁忙时才需要向执行器投递一次处理任务
+     *
+     * 邮箱分为两条通道: 响应, Tick和定时器回调进入优先通道, 其余进入普通通道
+     * 优先通道先被处理, 但连续处理一定数量后会让出一条普通信封, 避免普通流量饿死
+     * 策略只作用于普通通道; 除kGrow外优先通道另有同样大小的容量, 超出时拒绝, 不会丢弃已有的信封
+     */
+    class ACTOR_API ActorMailbox final {
+
+        using Node = MailboxNode;
+
+        /// Vyukov侵入式MPSC队列
+        class Lane final {
+
+        public:
+            Lane();
+            ~Lane();
+
+            DISABLE_COPY_MOVE(Lane)
+
+            void enqueue(Node *node);
+            Node *dequeue();
+
+            void clear();
+
+        private:
+            // 生产者端
+            alignas(64) std::atomic<Node *> head_;
+
+            // 消费者端
+            alignas(64) Node *tail_;
+            Node stub_;
+        };
+
+    public:
+        /// kDropOldest下普通通道积压的上限相对于容量的倍数, 消费者只能在取出时丢弃, 生产者在此之前不受限制
+        static constexpr size_t kDropOldestSlack = 2;
+
+        ActorMailbox();
+        ~ActorMailbox();
+
+        DISABLE_COPY_MOVE(ActorMailbox)
+
+        void setCapacity(size_t capacity);
+        void setPolicy(MailboxPolicy policy);
+
+        /// 连续处理多少条优先信封后必须处理一条普通信封
+        void setStarvationBound(size_t bound);
+
+        /// 普通通道的高低水位, high为0表示不启用背压
+        void setWatermark(size_t high, size_t low);
+
+        /// 任意线程调用, 被拒绝或丢弃时返回false
+        bool push(Envelope &&evl);
+
+        /// 仅消费者调用, enqueued非空时返回信封进入邮箱的时间
+        bool pop(Envelope &evl, SteadyTimePoint *enqueued = nullptr);
+
+        /// 仅消费者调用, 丢弃所有未处理的信封
+        void clear();
+
+        /// 尝试将邮箱标记为已调度, 返回true表示调用者需要投递处理任务
+        bool schedule();
+
+        /// 消费者处理完一批后调用, 返回true表示仍有信封且调度权仍归调用者
+        bool release();
+
+        /// 生产者调用, 超过高水位时标记拥塞, 返回true表示生产者应暂停投递
+        /// 标记之后消费者一定会在降到低水位时通过relieve()观察到
+        bool congest();
+
+        /// 仅消费者调用, 拥塞状态下降到低水位时解除并返回true
+        bool relieve();
+
+        [[nodiscard]] bool isCongested() const;
+
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] size_t capacity() const;
+
+        [[nodiscard]] size_t rejected() const;
+        [[nodiscard]] size_t dropped() const;
+
+        [[nodiscard]] static bool isUrgent(const Envelope &evl);
+
+    private:
+        bool popUrgent(Envelope &evl, SteadyTimePoint *enqueued);
+        bool popNormal(Envelope &evl, SteadyTimePoint *enqueued);
+
+    private:
+        Lane urgent_;
+        Lane normal_;
+
+        std::atomic<size_t> urgentSize_;
+        std::atomic<size_t> size_;
+        std::atomic_bool scheduled_;
+
+        size_t capacity_;
+        MailboxPolicy policy_;
+
+        size_t highWatermark_;
+        size_t lowWatermark_;
+        std::atomic_bool congested_;
+
+        // 仅消费者访问
+        size_t starvationBound_;
+        size_t urgentStreak_;
+
+        std::atomic<size_t> rejected_;
+        std::atomic<size_t> dropped_;
+    };
+}
@@ -0,0 +1,273 @@
+#pragma once
+
+#include "actor/actor.export.h"
+
+#include <base/noncopy.h>
+#include <base/Recycler.h>
+#include <asio/execution.hpp>
+#include <asio/execution_context.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <atomic>
+
+
+namespace uranus::actor {
+
+    /// 固定任务当前所在的工作线程, 以及上次再平衡以来的执行耗时
+    struct ActorPlacement {
+        std::atomic<int> worker;
+        std::atomic<uint64_t> busy{0};
+
+        explicit ActorPlacement(const int index)
+            : worker(index) {
+        }
+    };
+
+    /**
+     * 调度器的任务节点, 从线程本地的回收池中获取, 执行后归还给分配它的线程
+     * 不超过kInlineSize字节的函数对象直接构造在节点内, 否则单独分配
+     */
+    class ACTOR_API SchedulerTask final {
+
+        DECLARE_RECYCLER_GET(SchedulerTask)
+
+        explicit SchedulerTask(const SchedulerTaskRecyclerHandle &handle);
+
+        struct Operations {
+            /// 执行后析构函数对象, 抛出异常时也会析构
+            void (*invoke)(void *);
+            void (*destroy)(void *) noexcept;
+        };
+
+    public:
+        static constexpr std::size_t kInlineSize = 8 * sizeof(void *);
+
+        ~SchedulerTask();
+
+        DISABLE_COPY_MOVE(SchedulerTask)
+
+        template<class F>
+        void emplace(F &&func);
+
+        void run();
+        void recycle();
+
+        std::shared_ptr<ActorPlacement> placement;
+
+    private:
+        template<class Functor>
+        static constexpr bool kIsInline =
+            sizeof(Functor) <= kInlineSize &&
+            alignof(Functor) <= alignof(std::max_align_t);
+
+        template<class Functor>
+        static void InvokeAndDestroy(Functor &func) {
+            struct Guard {
+                Functor &func;
+                ~Guard() { func.~Functor(); }
+            } guard{func};
+
+            std::move(func)();
+        }
+
+        template<class Functor>
+        static constexpr Operations kInlineOps = {
+            [](void *ptr) {
+                InvokeAndDestroy(*static_cast<Functor *>(ptr));
+            },
+            [](void *ptr) noexcept {
+                static_cast<Functor *>(ptr)->~Functor();
+            }
+        };
+
+        template<class Functor>
+        static constexpr Operations kHeapOps = {
+            [](void *ptr) {
+                const std::unique_ptr<Functor> func(*static_cast<Functor **>(ptr));
+                std::move(*func)();
+            },
+            [](void *ptr) noexcept {
+                delete *static_cast<Functor **>(ptr);
+            }
+        };
+
+    private:
+        alignas(std::max_align_t) std::byte storage_[kInlineSize];
+        const Operations *ops_;
+
+        SchedulerTaskRecyclerHandle handle_;
+    };
+
+    DECLARE_RECYCLER(SchedulerTask)
+
+    template<class F>
+    void SchedulerTask::emplace(F &&func) {
+        using Functor = std::decay_t<F>;
+
+        if constexpr (kIsInline<Functor>) {
+            ::new (static_cast<void *>(storage_)) Functor(std::forward<F>(func));
+            ops_ = &kInlineOps<Functor>;
+        } else {
+            ::new (static_cast<void *>(storage_)) Functor *(new Functor(std::forward<F>(func)));
+            ops_ = &kHeapOps<Functor>;
+        }
+    }
+
+    /**
+     * 工作窃取调度器
+     * 每个工作线程拥有自己的运行队列, 空闲时从其它线程的队列中窃取任务,
+     * 可以代替SingleIOContextPool作为Actor strand的底层执行器
+     * 非工作线程投递的任务轮流放入各线程的运行队列, 不会集中在同一把锁上
+     *
+     * 固定线程的Actor通过Placement投递任务, rebalance()可以把Placement从繁忙的线程迁移到空闲的线程
+     * strand同一时刻只有一个调用者在队列中, 所以迁移不会丢失或打乱消息, 绑定在strand上的定时器也不受影响
+     */
+    class ACTOR_API ActorScheduler final : public asio::execution_context {
+
+    public:
+        using Placement = ActorPlacement;
+        using PlacementHandle = std::shared_ptr<Placement>;
+
+    private:
+        using TaskHandle = Recycler<SchedulerTask>::TypeUniquePtr;
+
+        struct Worker {
+            std::thread th;
+            std::mutex mutex;
+            std::deque<TaskHandle> queue;
+
+            // 固定在该线程执行的任务, 不允许被窃取
+            std::deque<TaskHandle> pinned;
+            std::atomic<size_t> pinnedCount{0};
+
+            // 上次再平衡以来执行固定任务的耗时, 纳秒
+            std::atomic<uint64_t> busy{0};
+
+            // 由sleepMutex_保护
+            std::condition_variable cond;
+            bool sleeping = false;
+        };
+
+    public:
+        class executor_type {
+
+        public:
+            explicit executor_type(ActorScheduler &ctx, const int worker = -1) noexcept
+                : ctx_(&ctx),
+                  worker_(worker) {
+            }
+
+            executor_type(ActorScheduler &ctx, PlacementHandle placement) noexcept
+                : ctx_(&ctx),
+                  worker_(-1),
+                  placement_(std::move(placement)) {
+            }
+
+            [[nodiscard]] ActorScheduler &query(asio::execution::context_t) const noexcept {
+                return *ctx_;
+            }
+
+            static constexpr asio::execution::blocking_t query(asio::execution::blocking_t) noexcept {
+                return asio::execution::blocking.never;
+            }
+
+            [[nodiscard]] executor_type require(asio::execution::blocking_t::never_t) const noexcept {
+                return *this;
+            }
+
+            template<class Function>
+            void execute(Function &&func) const {
+                TaskHandle task(SchedulerTask::get());
+                task->emplace(std::forward<Function>(func));
+                task->placement = placement_;
+                ctx_->post(std::move(task), worker_);
+            }
+
+            /// 固定的工作线程下标, -1表示可由任意线程执行
+            [[nodiscard]] int worker() const noexcept {
+                if (placement_)
+                    return placement_->worker.load(std::memory_order_acquire);
+                return worker_;
+            }
+
+            bool operator==(const executor_type &rhs) const noexcept {
+                return ctx_ == rhs.ctx_ && worker_ == rhs.worker_ && placement_ == rhs.placement_;
+            }
+
+            bool operator!=(const executor_type &rhs) const noexcept {
+                return !(*this == rhs);
+            }
+
+        private:
+            ActorScheduler *ctx_;
+            int worker_;
+            PlacementHandle placement_;
+        };
+
+        explicit ActorScheduler(size_t capacity = 4);
+        ~ActorScheduler();
+
+        DISABLE_COPY_MOVE(ActorScheduler)
+
+        /// 启动工作线程, cores非空时第i个线程绑定到cores[i % cores.size()]
+        void start(const std::vector<int> &cores = {});
+        void stop();
+
+        [[nodiscard]] executor_type get_executor() noexcept;
+
+        /// 返回固定在指定工作线程上执行的执行器
+        [[nodiscard]] executor_type get_executor(size_t worker) noexcept;
+
+        /// 返回跟随Placement的执行器, 应当包装在strand中使用
+        [[nodiscard]] executor_type get_executor(const PlacementHandle &placement) noexcept;
+
+        /// 创建初始位于指定工作线程的可迁移Placement
+        [[nodiscard]] PlacementHandle createPlacement(size_t worker);
+
+        /**
+         * 比较各工作线程上次调用以来的固定任务耗时,
+         * 最忙线程超过平均值的ratio倍, 或其积压的固定任务超过backlog(0表示不检查)时,
+         * 把其上的部分Placement迁移到最空闲的线程, 返回迁移的数量
+         */
+        size_t rebalance(double ratio, size_t backlog = 0);
+
+        [[nodiscard]] size_t size() const;
+
+    private:
+        void post(TaskHandle &&task, int worker);
+        void run(size_t index);
+
+        void wakeUp(int worker);
+
+        TaskHandle acquire(size_t index);
+        TaskHandle steal(size_t index);
+
+    private:
+        std::vector<std::unique_ptr<Worker>> workers_;
+
+        // 非工作线程投递时轮流选择的运行队列
+        std::atomic<size_t> nextWorker_;
+
+        std::mutex sleepMutex_;
+
+        // 所有可迁移的Placement, 已销毁的由rebalance()顺带清理,
+        // 长时间不调用rebalance()时, 列表长度达到placementLimit_才在创建时清理一次
+        std::mutex placementMutex_;
+        std::vector<std::weak_ptr<Placement>> placements_;
+        size_t placementLimit_;
+
+        // 可被任意线程执行的待处理任务数量
+        std::atomic<size_t> pending_;
+        std::atomic<size_t> idle_;
+        std::atomic_bool started_;
+        std::atomic_bool stopped_;
+    };
+}
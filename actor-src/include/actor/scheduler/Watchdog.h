@@ -0,0 +1,58 @@
+#pragma once
+
+#include "actor/actor.export.h"
+
+#include <base/noncopy.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+
+namespace uranus::actor {
+
+    using SteadyTimePoint = std::chrono::steady_clock::time_point;
+    using SteadyDuration = std::chrono::steady_clock::duration;
+
+    /**
+     * 慢处理看门狗
+     * 工作线程在处理信封前后调用begin()/end()发布自己正在做什么, 看门狗线程定期采样,
+     * 单次处理超过预算时记录Actor id, 信封类型和Package id, 可选地抓取该线程的调用栈
+     */
+    class ACTOR_API Watchdog final {
+
+    public:
+        Watchdog() = delete;
+
+        /// backtrace仅在Linux下有效, 通过信号让被阻塞的线程自己记录调用栈
+        explicit Watchdog(SteadyDuration budget, bool backtrace = false);
+        ~Watchdog();
+
+        DISABLE_COPY_MOVE(Watchdog)
+
+        void start();
+        void stop();
+
+        /// 没有看门狗运行时工作线程不需要发布状态
+        [[nodiscard]] static bool isActive();
+
+        /// 工作线程调用, 发布即将处理的信封
+        static void begin(int64_t actor, int type, int64_t package, SteadyTimePoint now);
+
+        /// 工作线程调用, 当前信封处理结束
+        static void end();
+
+    private:
+        void run();
+
+    private:
+        SteadyDuration budget_;
+        bool backtrace_;
+
+        std::thread thread_;
+        std::mutex mutex_;
+        std::condition_variable cond_;
+        bool running_;
+    };
+}
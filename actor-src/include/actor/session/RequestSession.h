@@ -1,51 +1,38 @@
 #pragma once
 
+#include "actor/actor.export.h"
 #include "actor/Package.h"
 
 #include <base/types.h>
-#include <base/noncopy.h>
 #include <asio/any_completion_handler.hpp>
-#include <asio/executor_work_guard.hpp>
-#include <atomic>
-#include <memory>
+#include <cstdint>
 
 
 namespace uranus::actor {
 
     using SessionHandler = asio::any_completion_handler<void(PackageHandle)>;
-    using std::atomic_flag;
-    using std::shared_ptr;
-    using std::weak_ptr;
-    using std::enable_shared_from_this;
 
-    class BaseActorContext;
-    class SessionManager;
+    /**
+     * 会话表中的一个槽位, 由SessionManager复用
+     * 会话id的高32位是槽位的代数, 低32位是槽位下标, 槽位释放后代数加一, 旧id自然失效
+     */
+    struct ACTOR_API RequestSession final {
+        static constexpr uint32_t kInvalidIndex = UINT32_MAX;
 
-    class ACTOR_API RequestSession final : public enable_shared_from_this<RequestSession> {
+        static int64_t makeId(uint32_t index, uint32_t generation);
 
-        friend class SessionManager;
+        static uint32_t indexOf(int64_t id);
+        static uint32_t generationOf(int64_t id);
 
-    public:
-        RequestSession() = delete;
+        /// 保持在31位以内保证id为正数, 回绕时跳过0
+        static uint32_t nextGeneration(uint32_t generation);
 
-        RequestSession(const shared_ptr<BaseActorContext> &owner, SessionHandler &&handler, int64_t id);
-        ~RequestSession();
+        SessionHandler handler;
+        SteadyTimePoint deadline;
 
-        DISABLE_COPY_MOVE(RequestSession)
+        uint32_t generation = 1;
+        uint32_t nextFree = kInvalidIndex;
 
-    private:
-        void dispatch(PackageHandle &&res);
-        void cancel();
-
-    private:
-        asio::any_io_executor exec_;
-
-        int64_t id_;
-        SessionHandler handler_;
-        SteadyTimer timer_;
-
-        atomic_flag completed_;
-
-        weak_ptr<BaseActorContext> owner_;
+        bool active = false;
     };
 }
@@ -1,29 +1,23 @@
 #pragma once
 
-#include "actor/Package.h"
+#include "RequestSession.h"
 
 #include <base/noncopy.h>
-#include <base/IdentAllocator.h>
-
-#include <asio/any_completion_handler.hpp>
-#include <unordered_map>
-#include <memory>
+#include <vector>
+#include <utility>
 
 
 namespace uranus::actor {
 
-    using std::shared_ptr;
-    using std::make_shared;
-    using std::unordered_map;
-    using SessionHandler = asio::any_completion_handler<void(PackageHandle)>;
-
     class BaseActorContext;
-    class RequestSession;
-
 
+    /**
+     * 请求会话表, 只在所属Actor的执行器上访问
+     * 槽位复用不产生分配, 所有会话的超时由同一个定时器按最早的截止时间统一检查
+     */
     class ACTOR_API SessionManager final {
 
-        friend class RequestSession;
+        using DeadlineNode = std::pair<SteadyTimePoint, int64_t>;
 
     public:
         SessionManager() = delete;
@@ -33,20 +27,42 @@ namespace uranus::actor {
 
         DISABLE_COPY_MOVE(SessionManager)
 
-        int64_t pushSession(SessionHandler &&handler);
+        /// 截止时间为空时使用kDefaultTimeout
+        int64_t pushSession(SessionHandler &&handler, SteadyTimePoint deadline = {});
 
         void dispatch(int64_t id, PackageHandle &&res);
         void cancel(int64_t id);
 
         void cancelAll();
 
+        [[nodiscard]] size_t size() const;
+
+        static constexpr SteadyDuration kDefaultTimeout = std::chrono::seconds(5);
+
     private:
-        void removeOnComplete(int64_t id);
+        RequestSession *find(int64_t id);
+        void complete(int64_t id, PackageHandle &&res);
+
+        void arm(SteadyTimePoint deadline);
+        void sweep();
+
+        /// 已完成会话的节点超过一半时, 只用未完成的会话重建最小堆
+        void compact();
 
     private:
         BaseActorContext &ctx_;
 
-        IdentAllocator<int64_t, false> alloc_;
-        unordered_map<int64_t, shared_ptr<RequestSession>> sessions_;
+        std::vector<RequestSession> slots_;
+        uint32_t freeHead_;
+        size_t active_;
+
+        // 按截止时间排列的最小堆, 已完成会话的节点在到期时惰性丢弃, 或在compact()时统一清除
+        std::vector<DeadlineNode> deadlines_;
+
+        static constexpr size_t kCompactThreshold = 64;
+
+        SteadyTimer sweeper_;
+        SteadyTimePoint armedAt_;
+        bool armed_;
     };
 }
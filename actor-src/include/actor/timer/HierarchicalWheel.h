@@ -0,0 +1,82 @@
+#pragma once
+
+#include "actor/actor.export.h"
+
+#include <base/noncopy.h>
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace uranus::actor {
+
+    /// 时间轮中的侵入式链表节点
+    struct WheelNode {
+        WheelNode **slot_ = nullptr;
+        WheelNode *prev_ = nullptr;
+        WheelNode *next_ = nullptr;
+
+        /// 到期的格数
+        int64_t expire_ = 0;
+    };
+
+    /**
+     * 不带时钟的分层时间轮, 以格为单位推进, 不加锁
+     * 第0层256个槽, 其余3层各64个槽, 插入和取消都是O(1)
+     */
+    class ACTOR_API HierarchicalWheel final {
+
+    public:
+        static constexpr int64_t kRootBits  = 8;
+        static constexpr int64_t kLevelBits = 6;
+        static constexpr int64_t kLevels    = 3;
+
+        static constexpr int64_t kRootSize  = 1 << kRootBits;
+        static constexpr int64_t kLevelSize = 1 << kLevelBits;
+
+        static constexpr int64_t kRootMask  = kRootSize - 1;
+        static constexpr int64_t kLevelMask = kLevelSize - 1;
+
+        // 可以直接表示的最大间隔, 更远的节点先放在最高层, 级联时重新计算
+        static constexpr int64_t kMaxSpan   = int64_t(1) << (kRootBits + kLevelBits * kLevels);
+
+        HierarchicalWheel();
+        ~HierarchicalWheel();
+
+        DISABLE_COPY_MOVE(HierarchicalWheel)
+
+        /// 不早于下一格, expire_会被修正
+        void insert(WheelNode *node);
+        void remove(WheelNode *node);
+
+        /// 推进到now格, 到期的节点按到期顺序追加到expired
+        void advance(int64_t now, std::vector<WheelNode *> &expired);
+
+        /// 取出所有节点
+        void clear(std::vector<WheelNode *> &nodes);
+
+        /// 为空时直接对齐到tick格
+        void align(int64_t tick);
+
+        [[nodiscard]] int64_t current() const;
+        [[nodiscard]] std::size_t size() const;
+
+        [[nodiscard]] static bool linked(const WheelNode *node);
+
+    private:
+        void place(WheelNode *node);
+        static void link(WheelNode **slot, WheelNode *node);
+        static void unlink(WheelNode *node);
+
+        void cascade(int64_t level, int64_t index);
+
+    private:
+        std::array<WheelNode *, kRootSize> root_;
+        std::array<std::array<WheelNode *, kLevelSize>, kLevels> levels_;
+
+        // 已经处理过的最后一格
+        int64_t current_;
+        std::size_t count_;
+    };
+}
@@ -1,11 +1,13 @@
 ﻿#pragma once
 
 #include "actor/actor.export.h"
+#include "HierarchicalWheel.h"
 
 #include <base/types.h>
 #include <base/noncopy.h>
 #include <memory>
 #include <atomic>
+#include <optional>
 #include <functional>
 
 
@@ -13,6 +15,7 @@ namespace uranus::actor {
 
     class BaseActor;
     class BaseActorContext;
+    class TimingWheel;
 
     using std::shared_ptr;
     using std::weak_ptr;
@@ -22,9 +25,10 @@ namespace uranus::actor {
     using RepeatedTask = std::function<void(BaseActor *)>;
 
 
-    class ACTOR_API RepeatedTimer final : public enable_shared_from_this<RepeatedTimer> {
+    class ACTOR_API RepeatedTimer final : public enable_shared_from_this<RepeatedTimer>, private WheelNode {
 
         friend class TimerManager;
+        friend class TimingWheel;
 
     public:
         RepeatedTimer() = delete;
@@ -43,16 +47,26 @@ namespace uranus::actor {
 
         void setRepeatRate(SteadyDuration rate);
 
+        /// 设置后由时间轮驱动, 否则使用自己的SteadyTimer
+        void setWheel(TimingWheel *wheel);
+
         void start();
         void cancel();
 
+        /// 已取消, 所属Actor已销毁, 或者TimerManager::cancelAll()之后不再触发
+        [[nodiscard]] bool expired() const;
+
+        /// 从所属TimerManager的链表中移除, 只在Actor线程调用
+        void release();
+
     private:
         asio::any_io_executor exec_;
         const int64_t id_;
 
         weak_ptr<BaseActorContext> owner_;
 
-        SteadyTimer innerTimer_;
+        // 只有不经过时间轮时才构造
+        std::optional<SteadyTimer> innerTimer_;
         RepeatedTask task_;
 
         SteadyDuration delay_;
@@ -61,5 +75,22 @@ namespace uranus::actor {
 
         atomic_flag running_;
         atomic_flag completed_;
+        atomic_flag cancelled_;
+
+        TimingWheel *wheel_;
+
+        // 创建时TimerManager的纪元, cancelAll()时正在触发的定时器由纪元失效
+        uint64_t epoch_;
+
+        // 时间轮中的节点和重复间隔, 只在时间轮加锁后访问
+        int64_t interval_;
+
+        // 在时间轮中时持有自身 保证触发前不会被释放
+        shared_ptr<RepeatedTimer> linked_;
+
+        // TimerManager链表中的节点, 只在Actor线程访问; 在链表中时持有自身
+        RepeatedTimer *prevManaged_;
+        RepeatedTimer *nextManaged_;
+        shared_ptr<RepeatedTimer> managed_;
     };
 }
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "actor/actor.export.h"
+
+#include <base/noncopy.h>
+#include <base/types.h>
+#include <asio/awaitable.hpp>
+#include <memory>
+#include <mutex>
+#include <map>
+#include <vector>
+#include <unordered_map>
+
+
+namespace uranus::actor {
+
+    class BaseActorContext;
+
+    using std::shared_ptr;
+    using std::weak_ptr;
+    using std::unordered_map;
+    using asio::awaitable;
+
+    /**
+     * 合并的Tick服务
+     * 相同周期的Actor按混合后的指针哈希分配到若干分片, 每个分片每个周期只触发一次定时器,
+     * 然后批量向订阅的Actor投递TickInfo信封
+     */
+    class ACTOR_API TickService final {
+
+        struct Shard {
+            SteadyTimer timer;
+            SteadyDuration period;
+
+            std::mutex mutex;
+            unordered_map<BaseActorContext *, weak_ptr<BaseActorContext>> actors;
+
+            Shard(const asio::any_io_executor &exec, SteadyDuration period);
+        };
+
+        using ShardHandle = shared_ptr<Shard>;
+
+    public:
+        TickService() = delete;
+
+        TickService(asio::any_io_executor exec, size_t shards);
+        ~TickService();
+
+        DISABLE_COPY_MOVE(TickService)
+
+        /// 任意线程调用, 返回false表示服务已经停止
+        bool subscribe(const shared_ptr<BaseActorContext> &ctx, SteadyDuration period);
+        void unsubscribe(BaseActorContext *ctx, SteadyDuration period);
+
+        void stop();
+
+    private:
+        ShardHandle getShard(BaseActorContext *ctx, SteadyDuration period);
+
+        static awaitable<void> run(ShardHandle shard);
+
+    private:
+        asio::any_io_executor exec_;
+        const size_t shardCount_;
+
+        std::mutex mutex_;
+        std::map<SteadyDuration, std::vector<ShardHandle>> shards_;
+
+        bool stopped_;
+    };
+}
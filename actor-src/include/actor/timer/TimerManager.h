@@ -5,6 +5,7 @@
 #include <base/noncopy.h>
 #include <base/types.h>
 #include <base/IdentAllocator.h>
+#include <atomic>
 #include <memory>
 #include <unordered_map>
 #include <functional>
@@ -15,6 +16,7 @@ namespace uranus::actor {
     class BaseActorContext;
     class RepeatedTimer;
     class BaseActor;
+    class TimingWheel;
 
     using std::shared_ptr;
     using std::make_shared;
@@ -30,6 +32,7 @@ namespace uranus::actor {
     class ACTOR_API TimerManager final {
 
         friend class RepeatedTimer;
+        friend class TimingWheel;
 
     public:
         TimerManager() = delete;
@@ -46,13 +49,34 @@ namespace uranus::actor {
 
         void cancelAll();
 
+        /// cancelAll()时加一, 之前创建的定时器全部失效
+        [[nodiscard]] uint64_t epoch() const;
+
     private:
+        RepeatedTimerHandle startTimer(int64_t id, const shared_ptr<RepeatedTimer> &timer);
         void removeOnCompleted(int64_t id);
 
+        /// 时间轮中定时器的登记, 只在Actor线程调用, O(1)且不分配内存
+        void link(const shared_ptr<RepeatedTimer> &timer);
+        void unlink(RepeatedTimer *timer);
+
+        TimingWheel *getWheel();
+
     private:
         BaseActorContext &ctx_;
 
+        TimingWheel *wheel_;
+        bool resolved_;
+
         IdentAllocator<int64_t, false> alloc_;
+
+        // 只登记使用自身SteadyTimer的定时器
         unordered_map<int64_t, shared_ptr<RepeatedTimer>> timers_;
+
+        // 时间轮中的定时器串成侵入式链表, cancelAll()时逐个从时间轮中摘下
+        RepeatedTimer *wheelTimers_;
+
+        // 时间轮线程会读取, 正在触发的定时器由它兜底失效
+        std::atomic<uint64_t> epoch_;
     };
 }
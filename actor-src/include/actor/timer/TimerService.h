@@ -0,0 +1,31 @@
+#pragma once
+
+#include "TimingWheel.h"
+
+
+namespace uranus::actor {
+
+    class BaseActorContext;
+
+    /**
+     * 时间轮分片, 每个工作线程一个
+     * 同一个Actor的定时器总是落在同一个时间轮上
+     */
+    class ACTOR_API TimerService final {
+
+    public:
+        TimerService() = delete;
+
+        TimerService(const asio::any_io_executor &exec, size_t shards, SteadyDuration resolution = std::chrono::milliseconds(10));
+        ~TimerService();
+
+        DISABLE_COPY_MOVE(TimerService)
+
+        [[nodiscard]] TimingWheel *getWheel(const BaseActorContext *ctx) const;
+
+        void stop();
+
+    private:
+        std::vector<shared_ptr<TimingWheel>> wheels_;
+    };
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "actor/actor.export.h"
+#include "HierarchicalWheel.h"
+
+#include <base/noncopy.h>
+#include <base/types.h>
+#include <asio/awaitable.hpp>
+#include <memory>
+#include <mutex>
+
+
+namespace uranus::actor {
+
+    class RepeatedTimer;
+
+    using std::shared_ptr;
+    using asio::awaitable;
+
+    /**
+     * 分层时间轮, 以resolution为一格驱动HierarchicalWheel
+     * 每个时间轮只有一个SteadyTimer, 没有定时器时不会空转
+     */
+    class ACTOR_API TimingWheel final : public std::enable_shared_from_this<TimingWheel> {
+
+    public:
+        TimingWheel() = delete;
+
+        TimingWheel(const asio::any_io_executor &exec, SteadyDuration resolution);
+        ~TimingWheel();
+
+        DISABLE_COPY_MOVE(TimingWheel)
+
+        void start();
+        void stop();
+
+        /// 任意线程调用, 在point时刻第一次触发, rate大于0时之后按rate重复
+        bool schedule(const shared_ptr<RepeatedTimer> &timer, SteadyTimePoint point, SteadyDuration rate);
+
+        /// 任意线程调用
+        void cancel(RepeatedTimer *timer);
+
+    private:
+        awaitable<void> run();
+
+        void fire(const shared_ptr<RepeatedTimer> &timer);
+
+        [[nodiscard]] int64_t toTick(SteadyTimePoint point, bool ceil) const;
+
+    private:
+        SteadyTimer timer_;
+
+        const SteadyDuration resolution_;
+        const SteadyTimePoint origin_;
+
+        std::mutex mutex_;
+
+        HierarchicalWheel wheel_;
+
+        bool idle_;
+        bool stopped_;
+    };
+}
@@ -3,4 +3,18 @@
 namespace uranus::actor {
     ActorContext::ActorContext() = default;
     ActorContext::~ActorContext() = default;
+
+    ActorRef ActorContext::resolve(const string &type, const string &name) const {
+        const auto id = this->queryActorId(type, name);
+        if (id < 0)
+            return {};
+
+        if (type == "service")
+            return this->resolve(Package::kToService, id);
+
+        if (type == "player")
+            return this->resolve(Package::kToPlayer, id);
+
+        return {};
+    }
 }
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "ActorRef.h"
+#include "BaseActorContext.h"
+
+namespace uranus::actor {
+    ActorRef::ActorRef()
+        : type_(0),
+          id_(-1) {
+    }
+
+    ActorRef::ActorRef(const int type, const int64_t id, const std::weak_ptr<BaseActorContext> &target)
+        : type_(type),
+          id_(id),
+          target_(target) {
+    }
+
+    ActorRef::~ActorRef() = default;
+
+    ActorRef::ActorRef(const ActorRef &rhs) = default;
+    ActorRef &ActorRef::operator=(const ActorRef &rhs) = default;
+
+    ActorRef::ActorRef(ActorRef &&rhs) noexcept
+        : type_(rhs.type_),
+          id_(rhs.id_),
+          target_(std::move(rhs.target_)) {
+        rhs.type_ = 0;
+        rhs.id_ = -1;
+    }
+
+    ActorRef &ActorRef::operator=(ActorRef &&rhs) noexcept {
+        if (this != &rhs) {
+            type_ = rhs.type_;
+            id_ = rhs.id_;
+            target_ = std::move(rhs.target_);
+
+            rhs.type_ = 0;
+            rhs.id_ = -1;
+        }
+        return *this;
+    }
+
+    int ActorRef::getType() const {
+        return type_;
+    }
+
+    int64_t ActorRef::getId() const {
+        return id_;
+    }
+
+    bool ActorRef::isValid() const {
+        if (const auto ctx = target_.lock()) {
+            return ctx->isRunning();
+        }
+        return false;
+    }
+
+    ActorRef::operator bool() const {
+        return isValid();
+    }
+
+    std::shared_ptr<BaseActorContext> ActorRef::lock() const {
+        return target_.lock();
+    }
+
+    void ActorRef::reset() {
+        type_ = 0;
+        id_ = -1;
+        target_.reset();
+    }
+}
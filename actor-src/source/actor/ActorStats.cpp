@@ -0,0 +1,85 @@
+#include "ActorStats.h"
+
+#include <numeric>
+
+namespace uranus::actor {
+
+    static uint64_t ToNanoseconds(const SteadyDuration duration) {
+        if (duration <= SteadyDuration::zero())
+            return 0;
+
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    }
+
+    uint64_t ActorStatsSnapshot::totalMessages() const {
+        return std::accumulate(messages.begin(), messages.end(), uint64_t{0});
+    }
+
+    uint64_t ActorStatsSnapshot::totalHandleTime() const {
+        return std::accumulate(handleTime.begin(), handleTime.end(), uint64_t{0});
+    }
+
+    ActorStats::ActorStats()
+        : waitTime_(0),
+          maxWait_(0),
+          peakDepth_(0) {
+        for (auto &val : messages_) {
+            val.store(0, std::memory_order_relaxed);
+        }
+        for (auto &val : handleTime_) {
+            val.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ActorStats::~ActorStats() = default;
+
+    void ActorStats::record(const int type, const SteadyDuration handle, const SteadyDuration wait) {
+        if (type < 0 || type >= static_cast<int>(ActorStatsSnapshot::kTypeCount))
+            return;
+
+        messages_[type].fetch_add(1, std::memory_order_relaxed);
+        handleTime_[type].fetch_add(ToNanoseconds(handle), std::memory_order_relaxed);
+
+        const auto ns = ToNanoseconds(wait);
+        waitTime_.fetch_add(ns, std::memory_order_relaxed);
+
+        // 只有消费者写入最大值
+        if (ns > maxWait_.load(std::memory_order_relaxed)) {
+            maxWait_.store(ns, std::memory_order_relaxed);
+        }
+    }
+
+    void ActorStats::observeDepth(const size_t depth) {
+        auto peak = peakDepth_.load(std::memory_order_relaxed);
+        while (depth > peak && !peakDepth_.compare_exchange_weak(peak, depth, std::memory_order_relaxed)) {
+        }
+    }
+
+    ActorStatsSnapshot ActorStats::snapshot() const {
+        ActorStatsSnapshot result;
+
+        for (size_t idx = 0; idx < ActorStatsSnapshot::kTypeCount; ++idx) {
+            result.messages[idx] = messages_[idx].load(std::memory_order_relaxed);
+            result.handleTime[idx] = handleTime_[idx].load(std::memory_order_relaxed);
+        }
+
+        result.waitTime = waitTime_.load(std::memory_order_relaxed);
+        result.maxWait = maxWait_.load(std::memory_order_relaxed);
+        result.peakDepth = peakDepth_.load(std::memory_order_relaxed);
+
+        return result;
+    }
+
+    void ActorStats::reset() {
+        for (auto &val : messages_) {
+            val.store(0, std::memory_order_relaxed);
+        }
+        for (auto &val : handleTime_) {
+            val.store(0, std::memory_order_relaxed);
+        }
+
+        waitTime_.store(0, std::memory_order_relaxed);
+        maxWait_.store(0, std::memory_order_relaxed);
+        peakDepth_.store(0, std::memory_order_relaxed);
+    }
+}
@@ -5,7 +5,15 @@ namespace uranus::actor {
 
     BaseActor::BaseActor()
         : ctx_(nullptr),
-          enableTick_(false) {
+          requestDeadline_(),
+          enableTick_(false),
+          asyncRequest_(false),
+          tickPeriod_(std::chrono::milliseconds(500)),
+          mailboxBatch_(1),
+          mailboxCapacity_(1024),
+          mailboxPolicy_(MailboxPolicy::kReject),
+          mailboxHighWatermark_(0),
+          mailboxLowWatermark_(0) {
     }
 
     BaseActor::~BaseActor() {
@@ -25,6 +33,39 @@ namespace uranus::actor {
     void BaseActor::onTerminate() {
     }
 
+    BaseActor::DeadlineScope::DeadlineScope(SteadyTimePoint &target, const SteadyTimePoint value)
+        : deadline(target) {
+        deadline = value;
+    }
+
+    BaseActor::DeadlineScope::~DeadlineScope() {
+        deadline = {};
+    }
+
+    awaitable<PackageHandle> BaseActor::onRequestAsync(const int64_t src, PackageHandle req, const SteadyTimePoint deadline) {
+        // 同步执行, 没有挂起点, 与dispatchEnvelope()中的onRequest()一样在调用期间可见
+        DeadlineScope scope(requestDeadline_, deadline);
+        co_return this->onRequest(src, std::move(req));
+    }
+
+    void BaseActor::onMulticast(const int64_t src, const SharedPackage &pkg) {
+        if (pkg == nullptr)
+            return;
+
+        auto copy = Package::getHandle();
+        pkg->copy(*copy);
+
+        this->onPackage(src, std::move(copy));
+    }
+
+    void BaseActor::onEvent(const int64_t evt, const DataAsset *data) {
+        if (data == nullptr)
+            return;
+
+        const std::unique_ptr<DataAsset> copy(data->clone());
+        this->onEvent(evt, copy.get());
+    }
+
     void BaseActor::onTick(SteadyTimePoint now, SteadyDuration delta) {
     }
 
@@ -34,4 +75,19 @@ namespace uranus::actor {
         }
         return ctx_->getModule(name);
     }
+
+    SteadyTimePoint BaseActor::getRequestDeadline() const {
+        return requestDeadline_;
+    }
+
+    SteadyDuration BaseActor::getRemainingBudget() const {
+        if (requestDeadline_ == SteadyTimePoint{})
+            return SteadyDuration::max();
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= requestDeadline_)
+            return SteadyDuration::zero();
+
+        return requestDeadline_ - now;
+    }
 }
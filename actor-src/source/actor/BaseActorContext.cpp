@@ -1,26 +1,34 @@
 ﻿#include "BaseActorContext.h"
 #include "BaseActor.h"
+#include "scheduler/Watchdog.h"
 
-#include <asio/experimental/awaitable_operators.hpp>
 #include <asio/detached.hpp>
+#include <asio/post.hpp>
 #include <asio/co_spawn.hpp>
 #include <ranges>
+#include <algorithm>
 
 
 namespace uranus::actor {
 
-    using namespace asio::experimental::awaitable_operators;
     using asio::co_spawn;
     using asio::detached;
 
     BaseActorContext::BaseActorContext(asio::any_io_executor ctx, ActorHandle &&actor)
         : exec_(std::move(ctx)),
           handle_(std::move(actor)),
-          mailbox_(exec_, 1024),
+          quota_(1),
+          actorId_(-1),
           ticker_(exec_),
+          tickService_(nullptr),
           sessionManager_(*this),
           timerManager_(*this) {
 
+        mailbox_.setCapacity(handle_->mailboxCapacity_);
+        mailbox_.setPolicy(handle_->mailboxPolicy_);
+        mailbox_.setWatermark(handle_->mailboxHighWatermark_, handle_->mailboxLowWatermark_);
+
+        quota_ = std::max<size_t>(handle_->mailboxBatch_, 1);
     }
 
     BaseActorContext::~BaseActorContext() {
@@ -44,32 +52,51 @@ namespace uranus::actor {
 
         handle_->onStart(data.get());
 
-        co_spawn(exec_, [self = shared_from_this()]() mutable -> awaitable<void> {
-            if (self->handle_->enableTick_) {
-                co_await(
-                  self->process() &&
-                  self->tick()
-                );
+        if (handle_->enableTick_) {
+            // 优先使用共享的Tick服务 不可用时退化为自己的定时器
+            if (auto *service = getTickService(); service && service->subscribe(shared_from_this(), handle_->tickPeriod_)) {
+                tickService_ = service;
             } else {
-                co_await self->process();
+                co_spawn(exec_, [self = shared_from_this()]() mutable -> awaitable<void> {
+                    co_await self->tick();
+                }, detached);
             }
-        }, detached);
+        }
     }
 
     void BaseActorContext::terminate() {
         if (terminated_.test_and_set(std::memory_order_acq_rel))
             return;
 
-        asio::dispatch(exec_, [self = shared_from_this()]() mutable {
-            if (self->terminated_.test(std::memory_order_acquire))
-                return;
+        if (tickService_ != nullptr) {
+            tickService_->unsubscribe(this, handle_->tickPeriod_);
+        }
 
+        asio::dispatch(exec_, [self = shared_from_this()]() mutable {
             self->ticker_.cancel();
-            self->mailbox_.cancel();
-            self->mailbox_.close();
+
+            // 不再处理剩余的信封 被暂停的生产者需要恢复
+            if (self->mailbox_.isCongested()) {
+                self->onMailboxRelieved();
+            }
+
+            self->mailbox_.clear();
 
             self->sessionManager_.cancelAll();
             self->timerManager_.cancelAll();
+
+            // 从未运行过的Actor不需要回调onTerminate
+            if (!self->running_.test(std::memory_order_acquire))
+                return;
+
+            try {
+                self->cleanUp();
+
+                // Call actor terminate
+                self->handle_->onTerminate();
+            } catch (std::exception &e) {
+                self->onException(e);
+            }
         });
     }
 
@@ -87,8 +114,7 @@ namespace uranus::actor {
     }
 
     bool BaseActorContext::isRunning() const {
-        return mailbox_.is_open()
-            && running_.test()
+        return running_.test()
             && !terminated_.test();
     }
 
@@ -103,7 +129,32 @@ namespace uranus::actor {
         if (!isRunning())
             return;
 
-        mailbox_.try_send_via_dispatch(std::error_code{}, std::move(envelope));
+        if (!mailbox_.push(std::move(envelope)))
+            return;
+
+        stats_.observeDepth(mailbox_.size());
+
+        // 只有邮箱由空闲转为繁忙的生产者需要投递处理任务
+        if (mailbox_.schedule()) {
+            asio::post(exec_, [self = shared_from_this()] {
+                self->drain();
+            });
+        }
+    }
+
+    bool BaseActorContext::checkCongestion() {
+        if (!isRunning())
+            return false;
+
+        return mailbox_.congest();
+    }
+
+    void BaseActorContext::setQuota(const size_t quota) {
+        quota_ = std::max<size_t>(quota, 1);
+    }
+
+    size_t BaseActorContext::getQuota() const {
+        return quota_;
     }
 
     RepeatedTimerHandle BaseActorContext::createTimer(
@@ -137,11 +188,29 @@ namespace uranus::actor {
         const int ty,
         const int64_t target,
         PackageHandle &&req,
+        SteadyTimePoint deadline,
         SessionHandler &&handle
     ) {
-        if (const auto sess = sessionManager_.pushSession(std::move(handle)); sess > 0) {
-            this->sendRequest(ty, sess, target, std::move(req));
+        // 处理请求期间发起的下游调用继承上游更早的截止时间
+        if (const auto upstream = handle_->requestDeadline_; upstream != SteadyTimePoint{}) {
+            if (deadline == SteadyTimePoint{} || upstream < deadline)
+                deadline = upstream;
         }
+
+        if (const auto sess = sessionManager_.pushSession(std::move(handle), deadline); sess > 0) {
+            this->sendRequest(ty, sess, target, std::move(req), deadline);
+        }
+    }
+
+    TickService *BaseActorContext::getTickService() const {
+        return nullptr;
+    }
+
+    TimerService *BaseActorContext::getTimerService() const {
+        return nullptr;
+    }
+
+    void BaseActorContext::onMailboxRelieved() {
     }
 
     void BaseActorContext::onErrorCode(std::error_code ec) {
@@ -157,6 +226,22 @@ namespace uranus::actor {
         return true;
     }
 
+    ActorStats &BaseActorContext::getStats() {
+        return stats_;
+    }
+
+    const ActorStats &BaseActorContext::getStats() const {
+        return stats_;
+    }
+
+    int64_t BaseActorContext::getActorId() const {
+        return actorId_.load(std::memory_order_relaxed);
+    }
+
+    void BaseActorContext::setActorId(const int64_t id) {
+        actorId_.store(id, std::memory_order_relaxed);
+    }
+
     SessionManager &BaseActorContext::getSessionManager() {
         return sessionManager_;
     }
@@ -165,93 +250,66 @@ namespace uranus::actor {
         return timerManager_;
     }
 
-    awaitable<void> BaseActorContext::process() {
-        try {
-            while (isRunning()) {
-                // 从邮箱中读取一条信息
-                auto [ec, evl] = co_await mailbox_.async_receive();
-
-                if (ec == asio::error::operation_aborted ||
-                    ec == asio::experimental::error::channel_closed) {
-                    break;
-                }
+    void BaseActorContext::drain() {
+        if (!isRunning())
+            return;
 
-                if (ec) {
-                    this->onErrorCode(ec);
-                    break;
+        try {
+            Envelope evl;
+            SteadyTimePoint enqueued;
+            size_t count = 0;
+
+            // 每次最多处理quota_条信封 然后让出执行器
+            while (count < quota_ && isRunning() && mailbox_.pop(evl, &enqueued)) {
+                const auto type = evl.type;
+                const auto begin = std::chrono::steady_clock::now();
+
+                // 看门狗运行时发布当前处理的信封
+                const bool watched = Watchdog::isActive();
+                if (watched) {
+                    int64_t pkgId = 0;
+                    if (const auto *pkg = evl.getPackage(); pkg != nullptr && *pkg) {
+                        pkgId = (*pkg)->getId();
+                    } else if (const auto *shared = evl.getSharedPackage(); shared != nullptr && *shared) {
+                        pkgId = (*shared)->getId();
+                    }
+                    Watchdog::begin(this->getActorId(), type, pkgId, begin);
                 }
 
-                if (!isRunning())
-                    break;
+                this->dispatchEnvelope(std::move(evl));
+                ++count;
 
-                switch (evl.type) {
-                    case Envelope::kPackage: {
-                        if (auto *pkg = std::get_if<PackageHandle>(&evl.variant)) {
-                            handle_->onPackage(evl.source, std::move(*pkg));
-                        }
-                    }
-                    break;
-                    case Envelope::kRequest: {
-                        if (auto *pkg = std::get_if<PackageHandle>(&evl.variant)) {
-                            const auto sess = evl.session;
-                            const auto from = evl.source;
-
-                            int type = 0;
-                            if ((evl.type & Package::kFromPlayer) != 0) {
-                                type = Package::kToPlayer;
-                            }
-                            if ((evl.type & Package::kFromService) != 0) {
-                                type = Package::kToService;
-                            }
-
-                            auto res = handle_->onRequest(evl.source, std::move(*pkg));
-                            this->sendResponse(type, sess, from, std::move(res));
-                        }
-                    }
-                    break;
-                    case Envelope::kResponse: {
-                        if (auto *res = std::get_if<PackageHandle>(&evl.variant)) {
-                            sessionManager_.dispatch(evl.session, std::move(*res));
-                        }
-                    }
-                    break;
-                    case Envelope::kDataAsset: {
-                        if (const auto *da = std::get_if<DataAssetHandle>(&evl.variant)) {
-                            handle_->onEvent(evl.event, da->get());
-                        }
-                    }
-                    break;
-                    case Envelope::kTickInfo: {
-                        if (const auto *info = std::get_if<ActorTickInfo>(&evl.variant)) {
-                            handle_->onTick(info->now, info->delta);
-                        }
-                    }
-                    break;
-                    case Envelope::kCallback: {
-                        if (auto *task = std::get_if<ActorCallback>(&evl.variant)) {
-                            std::invoke(*task, handle_.get());
-                        }
-                    }
-                    break;
-                    default: break;
+                if (watched) {
+                    Watchdog::end();
                 }
-            }
-
-            this->cleanUp();
 
-            // Call actor terminate
-            handle_->onTerminate();
+                stats_.record(type, std::chrono::steady_clock::now() - begin, begin - enqueued);
+            }
         } catch (std::exception &e) {
+            Watchdog::end();
             this->onException(e);
         }
+
+        if (!isRunning())
+            return;
+
+        if (mailbox_.relieve()) {
+            this->onMailboxRelieved();
+        }
+
+        if (mailbox_.release()) {
+            asio::post(exec_, [self = shared_from_this()] {
+                self->drain();
+            });
+        }
     }
 
     awaitable<void> BaseActorContext::tick() {
         try {
             auto point = std::chrono::steady_clock::now();
-            constexpr SteadyDuration kTickDelta = std::chrono::milliseconds(500);
+            const auto delta = handle_->tickPeriod_;
             while (isRunning()) {
-                point += kTickDelta;
+                point += delta;
                 ticker_.expires_at(point);
 
                 const auto [ec] = co_await ticker_.async_wait();
@@ -260,11 +318,120 @@ namespace uranus::actor {
                     break;
                 }
 
-                auto evl = Envelope::makeTickInfo(point, kTickDelta);
+                auto evl = Envelope::makeTickInfo(point, delta);
                 this->pushEnvelope(std::move(evl));
             }
         } catch (std::exception &e) {
             this->onException(e);
         }
     }
+
+    awaitable<void> BaseActorContext::processRequest(
+        const int ty,
+        const int64_t sess,
+        const int64_t from,
+        PackageHandle req,
+        const SteadyTimePoint deadline
+    ) {
+        try {
+            auto res = co_await handle_->onRequestAsync(from, std::move(req), deadline);
+
+            if (!isRunning())
+                co_return;
+
+            // 调用方已经超时, 响应没有接收者
+            if (deadline != SteadyTimePoint{} && std::chrono::steady_clock::now() >= deadline)
+                co_return;
+
+            this->sendResponse(ty, sess, from, std::move(res));
+        } catch (std::exception &e) {
+            this->onException(e);
+        }
+    }
+
+    void BaseActorContext::dispatchEnvelope(Envelope &&evl) {
+        switch (evl.type) {
+            case Envelope::kPackage: {
+                if (auto *pkg = evl.getPackage()) {
+                    handle_->onPackage(evl.source, std::move(*pkg));
+                }
+            }
+            break;
+            case Envelope::kRequest: {
+                if (auto *pkg = evl.getPackage()) {
+                    const auto sess = evl.session;
+                    const auto from = evl.source;
+
+                    // 调用方已超时放弃, 不再处理
+                    if (evl.deadline != SteadyTimePoint{} && std::chrono::steady_clock::now() >= evl.deadline)
+                        break;
+
+                    int type = 0;
+                    if ((evl.flag & Package::kFromPlayer) != 0) {
+                        type = Package::kToPlayer;
+                    }
+                    if ((evl.flag & Package::kFromService) != 0) {
+                        type = Package::kToService;
+                    }
+
+                    if (handle_->asyncRequest_) {
+                        co_spawn(exec_, [self = shared_from_this(), type, sess, from, deadline = evl.deadline, req = std::move(*pkg)]() mutable -> awaitable<void> {
+                            co_await self->processRequest(type, sess, from, std::move(req), deadline);
+                        }, detached);
+                        break;
+                    }
+
+                    PackageHandle res;
+
+                    // onRequest()抛出异常时也要清除, 否则之后的call()都会继承这个期限
+                    {
+                        BaseActor::DeadlineScope scope(handle_->requestDeadline_, evl.deadline);
+
+                        res = handle_->onRequest(evl.source, std::move(*pkg));
+                    }
+
+                    this->sendResponse(type, sess, from, std::move(res));
+                }
+            }
+            break;
+            case Envelope::kResponse: {
+                if (auto *res = evl.getPackage()) {
+                    sessionManager_.dispatch(evl.session, std::move(*res));
+                }
+            }
+            break;
+            case Envelope::kMulticast: {
+                if (const auto *pkg = evl.getSharedPackage()) {
+                    handle_->onMulticast(evl.source, *pkg);
+                }
+            }
+            break;
+            case Envelope::kDataAsset: {
+                if (const auto *da = evl.getDataAsset()) {
+                    handle_->onEvent(evl.event, da->get());
+                }
+            }
+            break;
+            case Envelope::kSharedEvent: {
+                if (const auto *da = evl.getSharedDataAsset()) {
+                    const DataAsset *data = da->get();
+                    handle_->onEvent(evl.event, data);
+                }
+            }
+            break;
+            case Envelope::kTickInfo: {
+                if (const auto *info = evl.getTickInfo()) {
+                    handle_->onTick(info->now, info->delta);
+                }
+            }
+            break;
+            case Envelope::kCallback: {
+                if (auto *task = evl.getCallback()) {
+                    (*task)(handle_.get());
+                }
+            }
+            break;
+            default: break;
+        }
+    }
 }
@@ -3,6 +3,9 @@
 
 namespace uranus::actor {
     BasePlayer::BasePlayer() {
+        // 客户端消息积压时暂停读取, 依靠TCP流量控制限速
+        mailboxHighWatermark_ = mailboxCapacity_ * 3 / 4;
+        mailboxLowWatermark_ = mailboxCapacity_ / 4;
     }
 
     BasePlayer::~BasePlayer() {
@@ -17,4 +20,15 @@ namespace uranus::actor {
             getContext()->send(Package::kToService, sid, std::move(pkg));
         }
     }
+
+    ActorRef BasePlayer::resolveService(const std::string &name) const {
+        return getContext()->resolve("service", name);
+    }
+
+    void BasePlayer::sendToService(const ActorRef &ref, PackageHandle &&pkg) const {
+        if (ref.getType() != Package::kToService)
+            return;
+
+        getContext()->send(ref, std::move(pkg));
+    }
 }
@@ -12,13 +12,32 @@ namespace uranus::actor {
         getContext()->send(Package::kToClient, 0, std::move(pkg));
     }
 
+    void BaseService::sendToClients(const std::set<int64_t> &pids, PackageHandle &&pkg) const {
+        getContext()->multicast(Package::kToClient, pids, std::move(pkg));
+    }
+
     void BaseService::sendToPlayer(const int64_t pid, PackageHandle &&pkg) const {
         getContext()->send(Package::kToPlayer, pid, std::move(pkg));
     }
 
+    void BaseService::sendToPlayers(const std::set<int64_t> &pids, PackageHandle &&pkg) const {
+        getContext()->multicast(Package::kToPlayer, pids, std::move(pkg));
+    }
+
     void BaseService::sendToService(const std::string &name, PackageHandle &&pkg) const {
         if (const auto sid = getContext()->queryActorId("service", name); sid > 0) {
             getContext()->send(Package::kToService, sid, std::move(pkg));
         }
     }
+
+    ActorRef BaseService::resolveService(const std::string &name) const {
+        return getContext()->resolve("service", name);
+    }
+
+    void BaseService::sendToService(const ActorRef &ref, PackageHandle &&pkg) const {
+        if (ref.getType() != Package::kToService)
+            return;
+
+        getContext()->send(ref, std::move(pkg));
+    }
 }
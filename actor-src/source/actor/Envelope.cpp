@@ -1,42 +1,130 @@
 #include "Envelope.h"
 
+#include <memory>
+
 namespace uranus::actor {
     Envelope::Envelope()
         : type(0),
           flag(0),
           source(0),
-          session(0) {
+          session(0),
+          deadline() {
     }
 
-    Envelope::Envelope(Envelope &&rhs) noexcept {
-        if (this != &rhs) {
-            type = rhs.type;
-            flag = rhs.flag;
-            source = rhs.source;
-            session = rhs.session;
-
-            rhs.type = 0;
-            rhs.source = 0;
-            rhs.session = 0;
+    Envelope::~Envelope() {
+        this->reset();
+    }
 
-            variant = std::move(rhs.variant);
-        }
+    Envelope::Envelope(Envelope &&rhs) noexcept
+        : type(0),
+          flag(0),
+          source(0),
+          session(0),
+          deadline() {
+        this->relocate(rhs);
     }
 
     Envelope &Envelope::operator=(Envelope &&rhs) noexcept {
         if (this != &rhs) {
-            type = rhs.type;
-            flag = rhs.flag;
-            source = rhs.source;
-            session = rhs.session;
+            this->reset();
+            this->relocate(rhs);
+        }
+        return *this;
+    }
+
+    PackageHandle *Envelope::getPackage() {
+        switch (type) {
+            case kPackage:
+            case kRequest:
+            case kResponse:
+                return &package_;
+            default:
+                return nullptr;
+        }
+    }
+
+    SharedPackage *Envelope::getSharedPackage() {
+        return type == kMulticast ? &sharedPackage_ : nullptr;
+    }
+
+    DataAssetHandle *Envelope::getDataAsset() {
+        return type == kDataAsset ? &dataAsset_ : nullptr;
+    }
+
+    SharedDataAsset *Envelope::getSharedDataAsset() {
+        return type == kSharedEvent ? &sharedDataAsset_ : nullptr;
+    }
+
+    ActorTickInfo *Envelope::getTickInfo() {
+        return type == kTickInfo ? &tickInfo_ : nullptr;
+    }
+
+    ActorCallback *Envelope::getCallback() {
+        return type == kCallback ? &callback_ : nullptr;
+    }
+
+    void Envelope::reset() noexcept {
+        switch (type) {
+            case kPackage:
+            case kRequest:
+            case kResponse:
+                std::destroy_at(&package_);
+                break;
+            case kMulticast:
+                std::destroy_at(&sharedPackage_);
+                break;
+            case kDataAsset:
+                std::destroy_at(&dataAsset_);
+                break;
+            case kSharedEvent:
+                std::destroy_at(&sharedDataAsset_);
+                break;
+            case kCallback:
+                std::destroy_at(&callback_);
+                break;
+            default: break;
+        }
 
-            rhs.type = 0;
-            rhs.source = 0;
-            rhs.session = 0;
+        type = 0;
+        flag = 0;
+        source = 0;
+        session = 0;
+        deadline = {};
+    }
 
-            variant = std::move(rhs.variant);
+    void Envelope::relocate(Envelope &rhs) noexcept {
+        // 调用前当前信封必须为空
+        type = rhs.type;
+        flag = rhs.flag;
+        source = rhs.source;
+        session = rhs.session;
+        deadline = rhs.deadline;
+
+        switch (type) {
+            case kPackage:
+            case kRequest:
+            case kResponse:
+                std::construct_at(&package_, std::move(rhs.package_));
+                break;
+            case kMulticast:
+                std::construct_at(&sharedPackage_, std::move(rhs.sharedPackage_));
+                break;
+            case kDataAsset:
+                std::construct_at(&dataAsset_, std::move(rhs.dataAsset_));
+                break;
+            case kSharedEvent:
+                std::construct_at(&sharedDataAsset_, std::move(rhs.sharedDataAsset_));
+                break;
+            case kTickInfo:
+                tickInfo_ = rhs.tickInfo_;
+                break;
+            case kCallback:
+                std::construct_at(&callback_, std::move(rhs.callback_));
+                break;
+            default: break;
         }
-        return *this;
+
+        rhs.reset();
     }
 
     Envelope Envelope::makePackage(const int flag, const int64_t src, PackageHandle &&pkg) {
@@ -45,20 +133,27 @@ namespace uranus::actor {
         evl.type = kPackage;
         evl.flag = flag;
         evl.source = src;
-        evl.variant = std::move(pkg);
+        std::construct_at(&evl.package_, std::move(pkg));
 
         return evl;
     }
 
-    Envelope Envelope::makeRequest(const int flag, const int64_t src, const int64_t sess, PackageHandle &&req) {
+    Envelope Envelope::makeRequest(
+        const int flag,
+        const int64_t src,
+        const int64_t sess,
+        PackageHandle &&req,
+        const SteadyTimePoint deadline
+    ) {
         Envelope evl;
 
         evl.type = kRequest;
         evl.flag = flag;
         evl.source = src;
         evl.session = sess;
+        evl.deadline = deadline;
 
-        evl.variant = std::move(req);
+        std::construct_at(&evl.package_, std::move(req));
 
         return evl;
     }
@@ -71,7 +166,19 @@ namespace uranus::actor {
         evl.source = src;
         evl.session = sess;
 
-        evl.variant = std::move(res);
+        std::construct_at(&evl.package_, std::move(res));
+
+        return evl;
+    }
+
+    Envelope Envelope::makeMulticast(const int flag, const int64_t src, const SharedPackage &pkg) {
+        Envelope evl;
+
+        evl.type = kMulticast;
+        evl.flag = flag;
+        evl.source = src;
+
+        std::construct_at(&evl.sharedPackage_, pkg);
 
         return evl;
     }
@@ -82,7 +189,18 @@ namespace uranus::actor {
         evl.type = kDataAsset;
         evl.event = evt;
 
-        evl.variant = std::move(data);
+        std::construct_at(&evl.dataAsset_, std::move(data));
+
+        return evl;
+    }
+
+    Envelope Envelope::makeSharedEvent(const int64_t evt, const SharedDataAsset &data) {
+        Envelope evl;
+
+        evl.type = kSharedEvent;
+        evl.event = evt;
+
+        std::construct_at(&evl.sharedDataAsset_, data);
 
         return evl;
     }
@@ -91,16 +209,16 @@ namespace uranus::actor {
         Envelope evl;
 
         evl.type = kTickInfo;
-        evl.variant = ActorTickInfo{now, delta};
+        std::construct_at(&evl.tickInfo_, ActorTickInfo{now, delta});
 
         return evl;
     }
 
-    Envelope Envelope::makeCallback(const ActorCallback &cb) {
+    Envelope Envelope::makeCallback(ActorCallback &&cb) {
         Envelope evl;
 
         evl.type = kCallback;
-        evl.variant = cb;
+        std::construct_at(&evl.callback_, std::move(cb));
 
         return evl;
     }
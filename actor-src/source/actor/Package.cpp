@@ -1,6 +1,7 @@
 #include "Package.h"
 
 #include <mimalloc.h>
+#include <array>
 
 
 namespace uranus::actor {
@@ -18,6 +19,45 @@ namespace uranus::actor {
         }
     }
 
+    namespace {
+        /// 缓冲区容量的级别, 从缓冲池取出的缓冲区容量正好是某一级
+        constexpr std::array<size_t, 4> kPayloadClasses = { 4096, 16384, 65536, 262144 };
+
+        /// 每个线程每一级最多缓存的缓冲区数量
+        constexpr size_t kPayloadClassLimit = 32;
+
+        /// 容量能满足size的最小级别, 超过最大级别时返回级别数量
+        size_t PayloadClassOf(const size_t size) {
+            for (size_t idx = 0; idx < kPayloadClasses.size(); ++idx) {
+                if (size <= kPayloadClasses[idx])
+                    return idx;
+            }
+            return kPayloadClasses.size();
+        }
+
+        /// 平凡的thread_local, 线程退出时缓冲池析构之后仍可以访问
+        thread_local bool kPayloadPoolDestroyed = false;
+
+        template<class Buffer>
+        struct PayloadPoolHolder {
+            std::array<std::vector<Buffer>, kPayloadClasses.size()> lists;
+
+            ~PayloadPoolHolder() {
+                kPayloadPoolDestroyed = true;
+            }
+        };
+
+        /// 线程本地的分级缓冲池, 谁回收就缓存在谁的线程; 线程退出过程中返回nullptr
+        template<class Buffer>
+        std::array<std::vector<Buffer>, kPayloadClasses.size()> *PayloadPool() {
+            if (kPayloadPoolDestroyed)
+                return nullptr;
+
+            thread_local PayloadPoolHolder<Buffer> holder;
+            return &holder.lists;
+        }
+    }
+
     Package::Package(const PackageRecyclerHandle &handle)
         : handle_(handle),
           id_(-1) {
@@ -51,6 +91,20 @@ namespace uranus::actor {
         std::memcpy(payload_.data(), data, length);
     }
 
+    void Package::reserve(const size_t size) {
+        if (payload_.capacity() >= size)
+            return;
+
+        if (!payload_.empty() || size <= kInlineCapacity) {
+            payload_.reserve(size);
+            return;
+        }
+
+        auto old = std::move(payload_);
+        payload_ = acquirePayload(size);
+        releasePayload(std::move(old));
+    }
+
     std::string Package::toString() const {
         return { payload_.begin(), payload_.end() };
     }
@@ -58,6 +112,13 @@ namespace uranus::actor {
     void Package::recycle() {
         id_ = -1;
         payload_.clear();
+
+        // 放不进任何级别的小缓冲区留给这个Package下次使用, 1~4KB的载荷不再每次重新分配
+        if (payload_.capacity() >= kPayloadClasses.front()) {
+            releasePayload(std::move(payload_));
+            payload_ = ByteArray();
+        }
+
         handle_.recycle(this);
     }
 
@@ -71,6 +132,61 @@ namespace uranus::actor {
         rhs.payload_ = payload_;
     }
 
+    Package::ByteArray Package::acquirePayload(const size_t size) {
+        ByteArray buffer;
+
+        const auto level = PayloadClassOf(size);
+        if (level >= kPayloadClasses.size()) {
+            buffer.reserve(size);
+            return buffer;
+        }
+
+        if (auto *pool = PayloadPool<ByteArray>(); pool != nullptr && !(*pool)[level].empty()) {
+            auto &list = (*pool)[level];
+            buffer = std::move(list.back());
+            list.pop_back();
+            return buffer;
+        }
+
+        // 按级别的容量分配, 回收后可以放回同一级
+        buffer.reserve(kPayloadClasses[level]);
+        return buffer;
+    }
+
+    void Package::releasePayload(ByteArray &&buffer) {
+        const auto capacity = buffer.capacity();
+
+        // 不足最小级别或超过最大级别的直接释放
+        if (capacity < kPayloadClasses.front() || capacity > kPayloadClasses.back())
+            return;
+
+        // 放入不超过其容量的最大级别
+        auto level = kPayloadClasses.size() - 1;
+        while (kPayloadClasses[level] > capacity) {
+            --level;
+        }
+
+        auto *pool = PayloadPool<ByteArray>();
+        if (pool == nullptr)
+            return;
+
+        if (auto &list = (*pool)[level]; list.size() < kPayloadClassLimit) {
+            buffer.clear();
+            list.emplace_back(std::move(buffer));
+        }
+    }
+
+    SharedPackage MakeSharedPackage(PackageHandle &&pkg) {
+        if (pkg == nullptr)
+            return nullptr;
+
+        // 沿用原有的删除器, 最后一个读者释放时回到回收池
+        auto deleter = pkg.get_deleter();
+        return { pkg.release(), [deleter](const Package *ptr) {
+            deleter(const_cast<Package *>(ptr));
+        }};
+    }
+
     IMPLEMENT_RECYCLER_GET(Package)
 
     IMPLEMENT_RECYCLER(Package)
@@ -2,23 +2,11 @@
 
 #include <asio/read.hpp>
 #include <asio/write.hpp>
-
-#if defined(_WIN32) || defined(_WIN64)
-#include <winsock2.h>
-#elifdef __APPLE__
-
-#elif
-#include <arpa/inet.h>
-#endif
+#include <cstring>
 
 
 namespace uranus::actor {
 
-    struct PackageHeader {
-        int64_t id = 0;
-        size_t length = 0;
-    };
-
     PackageCodec::PackageCodec(BaseConnection &conn)
         : MessageCodec(conn) {
     }
@@ -30,23 +18,26 @@ namespace uranus::actor {
         if (pkg == nullptr)
             co_return error_code{};
 
-        PackageHeader header;
+        error_code compressEc;
+        const auto compressed = framer_.deflatePayload(*pkg, compressEc);
+
+        if (compressEc)
+            co_return compressEc;
 
-#if defined(_WIN32) || defined(_WIN64) || defined(__APPLE__)
-        header.id       = static_cast<int64_t>(htonll(pkg->id_));
-        header.length   = static_cast<int64_t>(htonll(pkg->payload_.size()));
-#else
-        header.id       = static_cast<int64_t>(htobe64(pkg->id_));
-        header.length   = static_cast<int64_t>(htobe64(pkg->payload_.size()));
-#endif
+        const asio::const_buffer payload = compressed
+            ? asio::buffer(framer_.deflated())
+            : asio::buffer(pkg->payload_.data(), pkg->payload_.size());
 
-        if (pkg->payload_.empty()) {
-            const auto [ec, len] = co_await asio::async_write(socket(), asio::buffer(&header, sizeof(PackageHeader)));
+        uint8_t header[kMaxHeaderSize];
+        const auto headerSize = PackageFramer::writeHeader(framer_.getWriteFraming(), pkg->id_, payload.size(), compressed, header);
+
+        if (payload.size() == 0) {
+            const auto [ec, len] = co_await asio::async_write(socket(), asio::buffer(header, headerSize));
 
             if (ec)
                 co_return ec;
 
-            if (len != sizeof(PackageHeader)) {
+            if (len != headerSize) {
                 co_return ErrorCode::kReadHeaderLength;
             }
 
@@ -54,71 +45,177 @@ namespace uranus::actor {
         }
 
         const auto buffers = {
-            asio::buffer(&header, sizeof(PackageHeader)),
-            asio::buffer(pkg->payload_),
+            asio::const_buffer(header, headerSize),
+            payload,
         };
 
-        const auto payloadLength = pkg->payload_.size();
+        const auto payloadLength = payload.size();
         const auto [ec, len] = co_await asio::async_write(socket(), buffers);
 
         if (ec) {
             co_return ec;
         }
 
-        if (len != sizeof(PackageHeader) + payloadLength) {
+        if (len != headerSize + payloadLength) {
             co_return ErrorCode::kReadPayloadLength;
         }
 
         co_return error_code{};
     }
 
-    awaitable<PackageCodec::ResultTuple> PackageCodec::decode() {
-        PackageHeader header;
+    bool PackageCodec::gather(Package *pkg, WriteBatch &batch) {
+        if (pkg == nullptr)
+            return true;
 
-        // Read header
-        {
-            if (const auto [ec, len] = co_await asio::async_read(socket(), asio::buffer(&header, sizeof(PackageHeader))); ec) {
-                co_return make_tuple(ec, nullptr);
-            }
+        // 压缩失败时交给encode()报告错误
+        error_code compressEc;
+        const auto compressed = framer_.deflatePayload(*pkg, compressEc);
+
+        if (compressEc)
+            return false;
 
-#if defined(_WIN32) || defined(_WIN64) || defined(__APPLE__)
-            header.id       = static_cast<int64_t>(ntohll(header.id));
-            header.length   = static_cast<int64_t>(ntohll(header.length));
-#else
-            header.id       = static_cast<int64_t>(be64toh(header.id));
-            header.length   = static_cast<int64_t>(be64toh(header.length));
-#endif
+        uint8_t header[kMaxHeaderSize];
+
+        if (compressed) {
+            // 压缩结果会被下一条消息覆盖, 复制进批次
+            const auto &deflated = framer_.deflated();
+            const auto headerSize = PackageFramer::writeHeader(framer_.getWriteFraming(), pkg->id_, deflated.size(), true, header);
+            batch.append(header, headerSize);
+            batch.append(deflated.data(), deflated.size());
+            return true;
         }
 
-        auto pkg = Package::getHandle();
+        const auto headerSize = PackageFramer::writeHeader(framer_.getWriteFraming(), pkg->id_, pkg->payload_.size(), false, header);
 
-        pkg->id_ = header.id;
+        // 头部复制进批次, 载荷在写入完成前由写循环持有
+        batch.append(header, headerSize);
+        batch.reference(pkg->payload_.data(), pkg->payload_.size());
 
-        if (header.length > 0) {
-            pkg->payload_.resize(header.length);
-            const auto [ec, len] = co_await asio::async_read(socket(), asio::buffer(pkg->payload_));
+        return true;
+    }
 
-            if (ec) {
-                co_return make_tuple(ec, nullptr);
-            }
+    WireBuffer PackageCodec::serialize(const Package &pkg, const Framing framing) {
+        uint8_t header[kMaxHeaderSize];
+        const auto headerSize = PackageFramer::writeHeader(framing, pkg.id_, pkg.payload_.size(), false, header);
 
-            if (len != header.length) {
-                co_return make_tuple(ErrorCode::kWriteLength, nullptr);
-            }
+        auto buffer = std::make_shared<std::vector<uint8_t>>(headerSize + pkg.payload_.size());
+
+        std::memcpy(buffer->data(), header, headerSize);
+        if (!pkg.payload_.empty()) {
+            std::memcpy(buffer->data() + headerSize, pkg.payload_.data(), pkg.payload_.size());
         }
 
-        co_return make_tuple(error_code{}, std::move(pkg));
+        return buffer;
+    }
+
+    void PackageCodec::setReadFraming(const Framing framing) {
+        framer_.setReadFraming(framing);
+    }
+
+    void PackageCodec::setWriteFraming(const Framing framing) {
+        framer_.setWriteFraming(framing);
+    }
+
+    PackageCodec::Framing PackageCodec::getReadFraming() const {
+        return framer_.getReadFraming();
+    }
+
+    PackageCodec::Framing PackageCodec::getWriteFraming() const {
+        return framer_.getWriteFraming();
+    }
+
+    void PackageCodec::setMaxFrameSize(const size_t size) {
+        framer_.setMaxFrameSize(size);
+    }
+
+    size_t PackageCodec::getMaxFrameSize() const {
+        return framer_.getMaxFrameSize();
+    }
+
+    void PackageCodec::setCompressionOptions(const CompressionOptions &options) {
+        framer_.setCompressionOptions(options);
+    }
+
+    void PackageCodec::setReadCompression(const bool enable) {
+        framer_.setReadCompression(enable);
+    }
+
+    void PackageCodec::setWriteCompression(const bool enable) {
+        framer_.setWriteCompression(enable);
+    }
+
+    bool PackageCodec::getReadCompression() const {
+        return framer_.getReadCompression();
     }
 
-    std::string PackageCodecErrorCategory::message(int val) const {
-        switch (static_cast<PackageCodec::ErrorCode>(val)) {
-            case PackageCodec::ErrorCode::kReadHeaderLength:
-                return "Header's length incorrect while reading package";
-            case PackageCodec::ErrorCode::kReadPayloadLength:
-                return "Payload's length incorrect while reading package";
-            case PackageCodec::ErrorCode::kWriteLength:
-                return "Written bytes length incorrect";
+    bool PackageCodec::getWriteCompression() const {
+        return framer_.getWriteCompression();
+    }
+
+    awaitable<PackageCodec::ResultTuple> PackageCodec::decode() {
+        while (true) {
+            error_code parseEc;
+
+            if (auto pkg = framer_.parse(parseEc))
+                co_return make_tuple(error_code{}, std::move(pkg));
+
+            if (parseEc)
+                co_return make_tuple(parseEc, nullptr);
+
+            // 头部已经完整, 但载荷超过读缓冲区, 剩余部分直接读入Package
+            PackageFramer::FrameHeader header;
+            if (const auto headerSize = framer_.oversized(header); headerSize > 0) {
+                if (header.compressed && !framer_.getReadCompression())
+                    co_return make_tuple(ErrorCode::kDecompress, nullptr);
+
+                auto pkg = Package::getHandle();
+                pkg->id_ = header.id;
+
+                // 压缩的载荷先读入暂存区, 再解压到Package
+                uint8_t *target = nullptr;
+                if (header.compressed) {
+                    compressed_.resize(header.length);
+                    target = compressed_.data();
+                } else {
+                    pkg->reserve(header.length);
+                    pkg->payload_.resize(header.length);
+                    target = pkg->payload_.data();
+                }
+
+                const auto buffered = framer_.drain(headerSize, target);
+
+                const auto [ec, len] = co_await asio::async_read(socket(), asio::buffer(target + buffered, header.length - buffered));
+
+                if (ec) {
+                    co_return make_tuple(ec, nullptr);
+                }
+
+                if (len != header.length - buffered) {
+                    co_return make_tuple(ErrorCode::kWriteLength, nullptr);
+                }
+
+                if (header.compressed) {
+                    const auto inflateEc = framer_.inflatePayload(compressed_.data(), compressed_.size(), *pkg);
+
+                    // 偶尔出现的大包不长期占用内存
+                    compressed_.clear();
+                    compressed_.shrink_to_fit();
+
+                    if (inflateEc)
+                        co_return make_tuple(inflateEc, nullptr);
+                }
+
+                co_return make_tuple(error_code{}, std::move(pkg));
+            }
+
+            // 一次读取尽可能多的数据, 之后的包直接从缓冲区解析
+            const auto [ec, len] = co_await socket().async_read_some(framer_.prepare());
+
+            if (ec) {
+                co_return make_tuple(ec, nullptr);
+            }
+
+            framer_.commit(len);
         }
-        return "";
     }
 }
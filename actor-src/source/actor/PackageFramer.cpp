@@ -0,0 +1,446 @@
+#include "PackageFramer.h"
+
+#include <zlib.h>
+#include <algorithm>
+#include <cstring>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <winsock2.h>
+#elifdef __APPLE__
+
+#else
+#include <arpa/inet.h>
+#endif
+
+
+namespace uranus::actor {
+
+    /// 固定格式头部在网络上的布局
+    struct PackageHeader {
+        int64_t id = 0;
+        size_t length = 0;
+    };
+
+    /// 固定格式长度最高位的压缩标记
+    static constexpr uint64_t kFixedCompressedBit = 1ull << 63;
+
+    /// uint64的varint最多10字节
+    static constexpr size_t kMaxVarintSize = 10;
+
+    /// 服务器解压使用最大窗口, 兼容客户端任意的窗口设置
+    static constexpr int kInflateWindow = 15;
+
+    class PackageFramer::Deflater final {
+
+    public:
+        Deflater() = default;
+
+        ~Deflater() {
+            if (ready)
+                deflateEnd(&stream);
+        }
+
+        DISABLE_COPY_MOVE(Deflater)
+
+        z_stream stream{};
+        bool ready = false;
+    };
+
+    class PackageFramer::Inflater final {
+
+    public:
+        Inflater() = default;
+
+        ~Inflater() {
+            if (ready)
+                inflateEnd(&stream);
+        }
+
+        DISABLE_COPY_MOVE(Inflater)
+
+        z_stream stream{};
+        bool ready = false;
+    };
+
+    static size_t WriteVarint(uint64_t value, uint8_t *out) {
+        size_t size = 0;
+        while (value >= 0x80) {
+            out[size++] = static_cast<uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        out[size++] = static_cast<uint8_t>(value);
+        return size;
+    }
+
+    /// 返回读取的字节数, 数据不完整时返回0, 超过10字节时设置malformed
+    static size_t ReadVarint(const uint8_t *data, const size_t available, uint64_t &value, bool &malformed) {
+        value = 0;
+        for (size_t idx = 0; idx < available && idx < kMaxVarintSize; ++idx) {
+            value |= static_cast<uint64_t>(data[idx] & 0x7F) << (7 * idx);
+            if ((data[idx] & 0x80) == 0)
+                return idx + 1;
+        }
+
+        malformed = available >= kMaxVarintSize;
+        return 0;
+    }
+
+    size_t PackageFramer::writeHeader(
+        const Framing framing,
+        const int64_t id,
+        const size_t length,
+        const bool compressed,
+        uint8_t *out
+    ) {
+        if (framing == Framing::kCompact) {
+            const auto size = WriteVarint(static_cast<uint64_t>(id), out);
+            return size + WriteVarint((static_cast<uint64_t>(length) << 1) | (compressed ? 1 : 0), out + size);
+        }
+
+        const uint64_t field = compressed ? (length | kFixedCompressedBit) : length;
+
+        PackageHeader header;
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__APPLE__)
+        header.id       = static_cast<int64_t>(htonll(id));
+        header.length   = static_cast<int64_t>(htonll(field));
+#else
+        header.id       = static_cast<int64_t>(htobe64(id));
+        header.length   = static_cast<int64_t>(htobe64(field));
+#endif
+
+        std::memcpy(out, &header, sizeof(PackageHeader));
+        return sizeof(PackageHeader);
+    }
+
+    size_t PackageFramer::readHeader(
+        const Framing framing,
+        const uint8_t *data,
+        const size_t available,
+        FrameHeader &header,
+        error_code &ec
+    ) {
+        if (framing == Framing::kCompact) {
+            bool malformed = false;
+            uint64_t id = 0;
+            uint64_t field = 0;
+
+            const auto idSize = ReadVarint(data, available, id, malformed);
+            const auto lenSize = idSize > 0 ? ReadVarint(data + idSize, available - idSize, field, malformed) : 0;
+
+            if (malformed) {
+                ec = ErrorCode::kMalformedHeader;
+                return 0;
+            }
+
+            if (lenSize == 0)
+                return 0;
+
+            header.id = static_cast<int64_t>(id);
+            header.length = field >> 1;
+            header.compressed = (field & 1) != 0;
+
+            return idSize + lenSize;
+        }
+
+        if (available < sizeof(PackageHeader))
+            return 0;
+
+        PackageHeader raw;
+        std::memcpy(&raw, data, sizeof(PackageHeader));
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__APPLE__)
+        header.id       = static_cast<int64_t>(ntohll(raw.id));
+        const auto field = static_cast<uint64_t>(ntohll(raw.length));
+#else
+        header.id       = static_cast<int64_t>(be64toh(raw.id));
+        const auto field = static_cast<uint64_t>(be64toh(raw.length));
+#endif
+
+        header.length = field & ~kFixedCompressedBit;
+        header.compressed = (field & kFixedCompressedBit) != 0;
+
+        return sizeof(PackageHeader);
+    }
+
+    PackageFramer::PackageFramer()
+        : readFraming_(Framing::kFixed),
+          writeFraming_(Framing::kFixed),
+          maxFrameSize_(kDefaultMaxFrameSize),
+          compression_{ 512, Z_BEST_SPEED, 15 },
+          readCompression_(false),
+          writeCompression_(false),
+          readBuffer_(kReadBufferSize),
+          readHead_(0),
+          readTail_(0) {
+    }
+
+    PackageFramer::~PackageFramer() {
+    }
+
+    void PackageFramer::setReadFraming(const Framing framing) {
+        readFraming_ = framing;
+    }
+
+    void PackageFramer::setWriteFraming(const Framing framing) {
+        writeFraming_ = framing;
+    }
+
+    PackageFramer::Framing PackageFramer::getReadFraming() const {
+        return readFraming_;
+    }
+
+    PackageFramer::Framing PackageFramer::getWriteFraming() const {
+        return writeFraming_;
+    }
+
+    void PackageFramer::setMaxFrameSize(const size_t size) {
+        maxFrameSize_ = size;
+    }
+
+    size_t PackageFramer::getMaxFrameSize() const {
+        return maxFrameSize_;
+    }
+
+    void PackageFramer::setCompressionOptions(const CompressionOptions &options) {
+        compression_ = options;
+        compression_.level = std::clamp(compression_.level, Z_BEST_SPEED, Z_BEST_COMPRESSION);
+        compression_.window = std::clamp(compression_.window, 9, 15);
+    }
+
+    void PackageFramer::setReadCompression(const bool enable) {
+        readCompression_ = enable;
+    }
+
+    void PackageFramer::setWriteCompression(const bool enable) {
+        writeCompression_ = enable;
+    }
+
+    bool PackageFramer::getReadCompression() const {
+        return readCompression_;
+    }
+
+    bool PackageFramer::getWriteCompression() const {
+        return writeCompression_;
+    }
+
+    asio::mutable_buffer PackageFramer::prepare() {
+        // 未解析的数据移到开头, 腾出空间
+        if (readHead_ > 0) {
+            const auto available = readTail_ - readHead_;
+            if (available > 0) {
+                std::memmove(readBuffer_.data(), readBuffer_.data() + readHead_, available);
+            }
+            readHead_ = 0;
+            readTail_ = available;
+        }
+
+        return asio::buffer(readBuffer_.data() + readTail_, readBuffer_.size() - readTail_);
+    }
+
+    void PackageFramer::commit(const size_t size) {
+        readTail_ = std::min(readTail_ + size, readBuffer_.size());
+    }
+
+    PackageHandle PackageFramer::parse(error_code &ec) {
+        const auto available = readTail_ - readHead_;
+
+        FrameHeader header;
+        const auto headerSize = readHeader(readFraming_, readBuffer_.data() + readHead_, available, header, ec);
+
+        if (headerSize == 0)
+            return nullptr;
+
+        // 不信任对端声明的长度, 超过上限时不分配内存
+        if (header.length > maxFrameSize_) {
+            ec = ErrorCode::kFrameTooLarge;
+            return nullptr;
+        }
+
+        if (available - headerSize < header.length)
+            return nullptr;
+
+        if (header.compressed && !readCompression_) {
+            ec = ErrorCode::kDecompress;
+            return nullptr;
+        }
+
+        auto pkg = Package::getHandle();
+
+        pkg->id_ = header.id;
+
+        if (header.length > 0) {
+            const auto *data = readBuffer_.data() + readHead_ + headerSize;
+
+            // 直接从读缓冲区解压
+            if (header.compressed) {
+                if ((ec = inflatePayload(data, header.length, *pkg)))
+                    return nullptr;
+            } else {
+                pkg->reserve(header.length);
+                pkg->payload_.assign(data, data + header.length);
+            }
+        }
+
+        readHead_ += headerSize + header.length;
+
+        if (readHead_ == readTail_) {
+            readHead_ = readTail_ = 0;
+        }
+
+        return pkg;
+    }
+
+    size_t PackageFramer::oversized(FrameHeader &header) const {
+        error_code ec;
+        const auto headerSize = readHeader(readFraming_, readBuffer_.data() + readHead_, readTail_ - readHead_, header, ec);
+
+        if (headerSize == 0 || headerSize + header.length <= readBuffer_.size())
+            return 0;
+
+        return headerSize;
+    }
+
+    size_t PackageFramer::drain(const size_t headerSize, uint8_t *target) {
+        const auto buffered = readTail_ - readHead_ - headerSize;
+        if (buffered > 0) {
+            std::memcpy(target, readBuffer_.data() + readHead_ + headerSize, buffered);
+        }
+
+        readHead_ = readTail_ = 0;
+        return buffered;
+    }
+
+    bool PackageFramer::deflatePayload(const Package &pkg, error_code &ec) {
+        if (!writeCompression_ || pkg.payload_.size() < compression_.threshold)
+            return false;
+
+        if (deflater_ == nullptr) {
+            auto deflater = std::make_unique<Deflater>();
+
+            // 负的窗口位数表示raw deflate, 不写zlib头尾
+            if (deflateInit2(&deflater->stream, compression_.level, Z_DEFLATED, -compression_.window, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+                ec = ErrorCode::kCompress;
+                return false;
+            }
+
+            deflater->ready = true;
+            deflater_ = std::move(deflater);
+        }
+
+        auto &stream = deflater_->stream;
+
+        // Z_SYNC_FLUSH额外输出空块, 留出余量
+        deflated_.resize(deflateBound(&stream, pkg.payload_.size()) + 16);
+
+        stream.next_in = const_cast<Bytef *>(pkg.payload_.data());
+        stream.avail_in = static_cast<uInt>(pkg.payload_.size());
+
+        size_t produced = 0;
+
+        while (true) {
+            stream.next_out = deflated_.data() + produced;
+            stream.avail_out = static_cast<uInt>(deflated_.size() - produced);
+
+            if (const auto ret = deflate(&stream, Z_SYNC_FLUSH); ret != Z_OK && ret != Z_BUF_ERROR) {
+                ec = ErrorCode::kCompress;
+                return false;
+            }
+
+            produced = deflated_.size() - stream.avail_out;
+
+            // 输出区有剩余说明已经全部刷出
+            if (stream.avail_out > 0 && stream.avail_in == 0)
+                break;
+
+            deflated_.resize(deflated_.size() * 2);
+        }
+
+        deflated_.resize(produced);
+        return true;
+    }
+
+    const std::vector<uint8_t> &PackageFramer::deflated() const {
+        return deflated_;
+    }
+
+    error_code PackageFramer::inflatePayload(const uint8_t *data, const size_t size, Package &pkg) {
+        if (inflater_ == nullptr) {
+            auto inflater = std::make_unique<Inflater>();
+
+            if (inflateInit2(&inflater->stream, -kInflateWindow) != Z_OK)
+                return ErrorCode::kDecompress;
+
+            inflater->ready = true;
+            inflater_ = std::move(inflater);
+        }
+
+        auto &stream = inflater_->stream;
+
+        stream.next_in = const_cast<Bytef *>(data);
+        stream.avail_in = static_cast<uInt>(size);
+
+        // 解压后的长度同样受最大帧长度限制, 防止压缩炸弹
+        const auto initial = std::min(std::max<size_t>(size * 4, 256), maxFrameSize_);
+
+        pkg.reserve(initial);
+        pkg.payload_.resize(initial);
+
+        size_t produced = 0;
+
+        while (true) {
+            stream.next_out = pkg.payload_.data() + produced;
+            stream.avail_out = static_cast<uInt>(pkg.payload_.size() - produced);
+
+            if (const auto ret = inflate(&stream, Z_SYNC_FLUSH); ret != Z_OK && ret != Z_BUF_ERROR) {
+                pkg.payload_.clear();
+                return ErrorCode::kDecompress;
+            }
+
+            produced = pkg.payload_.size() - stream.avail_out;
+
+            if (stream.avail_out > 0 && stream.avail_in == 0)
+                break;
+
+            if (pkg.payload_.size() >= maxFrameSize_) {
+                // 恰好填满上限时, 输入已经用完且没有待输出的数据才算完整, 与未压缩的帧一样包含上限
+                if (stream.avail_in == 0) {
+                    uint8_t probe;
+                    stream.next_out = &probe;
+                    stream.avail_out = 1;
+
+                    if (const auto ret = inflate(&stream, Z_SYNC_FLUSH); ret == Z_BUF_ERROR || (ret == Z_OK && stream.avail_out > 0))
+                        break;
+                }
+
+                pkg.payload_.clear();
+                return ErrorCode::kFrameTooLarge;
+            }
+
+            pkg.payload_.resize(std::min(pkg.payload_.size() * 2, maxFrameSize_));
+        }
+
+        pkg.payload_.resize(produced);
+        return error_code{};
+    }
+
+    std::string PackageCodecErrorCategory::message(int val) const {
+        switch (static_cast<PackageFramer::ErrorCode>(val)) {
+            case PackageFramer::ErrorCode::kReadHeaderLength:
+                return "Header's length incorrect while reading package";
+            case PackageFramer::ErrorCode::kReadPayloadLength:
+                return "Payload's length incorrect while reading package";
+            case PackageFramer::ErrorCode::kWriteLength:
+                return "Written bytes length incorrect";
+            case PackageFramer::ErrorCode::kMalformedHeader:
+                return "Malformed compact header while reading package";
+            case PackageFramer::ErrorCode::kCompress:
+                return "Failed to compress payload";
+            case PackageFramer::ErrorCode::kDecompress:
+                return "Unexpected or corrupted compressed payload";
+            case PackageFramer::ErrorCode::kFrameTooLarge:
+                return "Frame length exceeds the maximum frame size";
+        }
+        return "";
+    }
+}
@@ -0,0 +1,306 @@
+#include "mailbox/ActorMailbox.h"
+
+
+namespace uranus::actor {
+
+    MailboxNode::MailboxNode(const MailboxNodeRecyclerHandle &handle)
+        : next(nullptr),
+          handle_(handle) {
+    }
+
+    MailboxNode::MailboxNode()
+        : next(nullptr),
+          handle_(nullptr) {
+    }
+
+    MailboxNode::~MailboxNode() = default;
+
+    void MailboxNode::recycle() {
+        next.store(nullptr, std::memory_order_relaxed);
+        value.reset();
+        handle_.recycle(this);
+    }
+
+    IMPLEMENT_RECYCLER_GET(MailboxNode)
+
+    IMPLEMENT_RECYCLER(MailboxNode)
+
+    ActorMailbox::Lane::Lane()
+        : head_(&stub_),
+          tail_(&stub_) {
+    }
+
+    ActorMailbox::Lane::~Lane() {
+        this->clear();
+    }
+
+    void ActorMailbox::Lane::enqueue(Node *node) {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        auto *prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    ActorMailbox::Node *ActorMailbox::Lane::dequeue() {
+        auto *tail = tail_;
+        auto *next = tail->next.load(std::memory_order_acquire);
+
+        if (tail == &stub_) {
+            if (next == nullptr)
+                return nullptr;
+
+            tail_ = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+
+        if (next != nullptr) {
+            tail_ = next;
+            return tail;
+        }
+
+        // 生产者已经交换了head_但还没有链接next 稍后再取
+        if (tail != head_.load(std::memory_order_acquire))
+            return nullptr;
+
+        this->enqueue(&stub_);
+
+        next = tail->next.load(std::memory_order_acquire);
+        if (next != nullptr) {
+            tail_ = next;
+            return tail;
+        }
+
+        return nullptr;
+    }
+
+    void ActorMailbox::Lane::clear() {
+        while (auto *node = this->dequeue()) {
+            node->recycle();
+        }
+    }
+
+    ActorMailbox::ActorMailbox()
+        : urgentSize_(0),
+          size_(0),
+          scheduled_(false),
+          capacity_(1024),
+          policy_(MailboxPolicy::kReject),
+          highWatermark_(0),
+          lowWatermark_(0),
+          congested_(false),
+          starvationBound_(8),
+          urgentStreak_(0),
+          rejected_(0),
+          dropped_(0) {
+    }
+
+    ActorMailbox::~ActorMailbox() {
+        this->clear();
+    }
+
+    void ActorMailbox::setCapacity(const size_t capacity) {
+        capacity_ = capacity;
+    }
+
+    void ActorMailbox::setPolicy(const MailboxPolicy policy) {
+        policy_ = policy;
+    }
+
+    void ActorMailbox::setStarvationBound(const size_t bound) {
+        starvationBound_ = bound > 0 ? bound : 1;
+    }
+
+    void ActorMailbox::setWatermark(const size_t high, const size_t low) {
+        highWatermark_ = high;
+        lowWatermark_ = low < high ? low : high;
+    }
+
+    bool ActorMailbox::push(Envelope &&evl) {
+        if (isUrgent(evl)) {
+            // 回调可以由任意发送者投递, 同样需要限制, 否则优先通道可以无限增长
+            if (urgentSize_.fetch_add(1, std::memory_order_acq_rel) >= capacity_ && policy_ != MailboxPolicy::kGrow) {
+                urgentSize_.fetch_sub(1, std::memory_order_acq_rel);
+                rejected_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            auto *node = Node::get();
+            node->value = std::move(evl);
+            node->enqueued = std::chrono::steady_clock::now();
+
+            urgent_.enqueue(node);
+            return true;
+        }
+
+        switch (policy_) {
+            case MailboxPolicy::kReject: {
+                if (size_.fetch_add(1, std::memory_order_acq_rel) >= capacity_) {
+                    size_.fetch_sub(1, std::memory_order_acq_rel);
+                    rejected_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+            }
+            break;
+            case MailboxPolicy::kDropOldest: {
+                // 消费者停滞时没有人丢弃旧信封, 积压到上限后丢弃新信封, 保证内存有界
+                if (size_.fetch_add(1, std::memory_order_acq_rel) >= capacity_ * kDropOldestSlack) {
+                    size_.fetch_sub(1, std::memory_order_acq_rel);
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+            }
+            break;
+            default: {
+                size_.fetch_add(1, std::memory_order_acq_rel);
+            }
+            break;
+        }
+
+        auto *node = Node::get();
+        node->value = std::move(evl);
+        node->enqueued = std::chrono::steady_clock::now();
+
+        normal_.enqueue(node);
+        return true;
+    }
+
+    bool ActorMailbox::pop(Envelope &evl, SteadyTimePoint *enqueued) {
+        // 优先通道连续处理达到上限且普通通道有积压时 先让出一条普通信封
+        if (urgentStreak_ >= starvationBound_) {
+            urgentStreak_ = 0;
+            if (this->popNormal(evl, enqueued))
+                return true;
+        }
+
+        if (this->popUrgent(evl, enqueued)) {
+            ++urgentStreak_;
+            return true;
+        }
+
+        urgentStreak_ = 0;
+        return this->popNormal(evl, enqueued);
+    }
+
+    void ActorMailbox::clear() {
+        while (auto *node = urgent_.dequeue()) {
+            node->recycle();
+            urgentSize_.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+        while (auto *node = normal_.dequeue()) {
+            node->recycle();
+            size_.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+        urgentStreak_ = 0;
+        congested_.store(false, std::memory_order_seq_cst);
+    }
+
+    bool ActorMailbox::schedule() {
+        return !scheduled_.exchange(true, std::memory_order_acq_rel);
+    }
+
+    bool ActorMailbox::release() {
+        scheduled_.store(false, std::memory_order_seq_cst);
+
+        // 释放之后生产者可能刚好写入 此时需要重新抢占调度标记 否则该信封会一直滞留
+        if (size_.load(std::memory_order_seq_cst) > 0 || urgentSize_.load(std::memory_order_seq_cst) > 0)
+            return this->schedule();
+
+        return false;
+    }
+
+    bool ActorMailbox::congest() {
+        if (highWatermark_ == 0 || size_.load(std::memory_order_seq_cst) < highWatermark_)
+            return false;
+
+        congested_.store(true, std::memory_order_seq_cst);
+
+        // 标记前消费者可能已经清空了邮箱, 这时不会再有relieve()来解除暂停
+        return size_.load(std::memory_order_seq_cst) > 0;
+    }
+
+    bool ActorMailbox::relieve() {
+        if (!congested_.load(std::memory_order_seq_cst))
+            return false;
+
+        if (size_.load(std::memory_order_seq_cst) > lowWatermark_)
+            return false;
+
+        return congested_.exchange(false, std::memory_order_seq_cst);
+    }
+
+    bool ActorMailbox::isCongested() const {
+        return congested_.load(std::memory_order_relaxed);
+    }
+
+    size_t ActorMailbox::size() const {
+        return size_.load(std::memory_order_relaxed) + urgentSize_.load(std::memory_order_relaxed);
+    }
+
+    size_t ActorMailbox::capacity() const {
+        return capacity_;
+    }
+
+    size_t ActorMailbox::rejected() const {
+        return rejected_.load(std::memory_order_relaxed);
+    }
+
+    size_t ActorMailbox::dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    bool ActorMailbox::isUrgent(const Envelope &evl) {
+        switch (evl.type) {
+            case Envelope::kResponse:
+            case Envelope::kTickInfo:
+            case Envelope::kCallback:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    bool ActorMailbox::popUrgent(Envelope &evl, SteadyTimePoint *enqueued) {
+        auto *node = urgent_.dequeue();
+        if (node == nullptr)
+            return false;
+
+        evl = std::move(node->value);
+        if (enqueued != nullptr) {
+            *enqueued = node->enqueued;
+        }
+        node->recycle();
+
+        urgentSize_.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    bool ActorMailbox::popNormal(Envelope &evl, SteadyTimePoint *enqueued) {
+        // 单消费者模型下只能由消费者丢弃 所以在取出时再处理超出容量的部分
+        if (policy_ == MailboxPolicy::kDropOldest) {
+            while (size_.load(std::memory_order_acquire) > capacity_) {
+                auto *node = normal_.dequeue();
+                if (node == nullptr)
+                    break;
+
+                node->recycle();
+                size_.fetch_sub(1, std::memory_order_acq_rel);
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        auto *node = normal_.dequeue();
+        if (node == nullptr)
+            return false;
+
+        evl = std::move(node->value);
+        if (enqueued != nullptr) {
+            *enqueued = node->enqueued;
+        }
+        node->recycle();
+
+        size_.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+}
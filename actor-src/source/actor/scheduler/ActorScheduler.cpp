@@ -0,0 +1,425 @@
+#include "scheduler/ActorScheduler.h"
+
+#include <base/ThreadAffinity.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+
+
+namespace uranus::actor {
+
+    // 当前线程所属的调度器及工作线程下标
+    static thread_local ActorScheduler *kCurrentScheduler = nullptr;
+    static thread_local size_t kCurrentWorker = 0;
+
+    static constexpr size_t kMinPlacementLimit = 64;
+
+    SchedulerTask::SchedulerTask(const SchedulerTaskRecyclerHandle &handle)
+        : storage_{},
+          ops_(nullptr),
+          handle_(handle) {
+    }
+
+    SchedulerTask::~SchedulerTask() {
+        if (ops_ != nullptr) {
+            ops_->destroy(storage_);
+        }
+    }
+
+    void SchedulerTask::run() {
+        if (const auto *ops = std::exchange(ops_, nullptr)) {
+            ops->invoke(storage_);
+        }
+    }
+
+    void SchedulerTask::recycle() {
+        // 未执行就被丢弃的任务, 例如调度器停止时队列中剩余的任务
+        if (const auto *ops = std::exchange(ops_, nullptr)) {
+            ops->destroy(storage_);
+        }
+
+        placement.reset();
+        handle_.recycle(this);
+    }
+
+    IMPLEMENT_RECYCLER_GET(SchedulerTask)
+
+    IMPLEMENT_RECYCLER(SchedulerTask)
+
+    ActorScheduler::ActorScheduler(const size_t capacity)
+        : nextWorker_(0),
+          placementLimit_(kMinPlacementLimit),
+          pending_(0),
+          idle_(0),
+          started_(false),
+          stopped_(false) {
+
+        // 线程启动前工作队列就已存在, 启动前投递的固定任务不会丢失
+        for (size_t idx = 0; idx < std::max<size_t>(capacity, 1); ++idx) {
+            workers_.emplace_back(std::make_unique<Worker>());
+        }
+    }
+
+    ActorScheduler::~ActorScheduler() {
+        stop();
+
+        // 先于成员析构关闭定时器等服务
+        shutdown();
+        destroy();
+    }
+
+    void ActorScheduler::start(const std::vector<int> &cores) {
+        if (started_.exchange(true, std::memory_order_acq_rel))
+            return;
+
+        for (size_t idx = 0; idx < workers_.size(); ++idx) {
+            auto &th = workers_[idx]->th;
+            th = std::thread([this, idx] {
+                this->run(idx);
+            });
+
+            if (cores.empty())
+                continue;
+
+            if (const auto core = cores[idx % cores.size()]; !SetThreadAffinity(th, core)) {
+                SPDLOG_WARN("Failed to bind scheduler worker[{}] to core {}", idx, core);
+            }
+        }
+    }
+
+    void ActorScheduler::stop() {
+        if (stopped_.exchange(true, std::memory_order_acq_rel))
+            return;
+
+        {
+            std::lock_guard lock(sleepMutex_);
+            for (const auto &worker : workers_) {
+                worker->cond.notify_all();
+            }
+        }
+
+        for (const auto &worker : workers_) {
+            if (worker->th.joinable()) {
+                worker->th.join();
+            }
+        }
+
+        for (const auto &worker : workers_) {
+            std::lock_guard lock(worker->mutex);
+            worker->queue.clear();
+            worker->pinned.clear();
+        }
+    }
+
+    ActorScheduler::executor_type ActorScheduler::get_executor() noexcept {
+        return executor_type(*this);
+    }
+
+    ActorScheduler::executor_type ActorScheduler::get_executor(const size_t worker) noexcept {
+        return executor_type(*this, static_cast<int>(worker % workers_.size()));
+    }
+
+    ActorScheduler::executor_type ActorScheduler::get_executor(const PlacementHandle &placement) noexcept {
+        return executor_type(*this, placement);
+    }
+
+    ActorScheduler::PlacementHandle ActorScheduler::createPlacement(const size_t worker) {
+        auto placement = std::make_shared<Placement>(static_cast<int>(worker % workers_.size()));
+
+        std::lock_guard lock(placementMutex_);
+
+        // 列表翻倍时才清理已经销毁的Placement, 均摊到每次创建是O(1)
+        if (placements_.size() >= placementLimit_) {
+            std::erase_if(placements_, [](const auto &weak) {
+                return weak.expired();
+            });
+            placementLimit_ = std::max(kMinPlacementLimit, placements_.size() * 2);
+        }
+
+        placements_.emplace_back(placement);
+        return placement;
+    }
+
+    size_t ActorScheduler::rebalance(const double ratio, const size_t backlog) {
+        const auto count = workers_.size();
+        if (count < 2)
+            return 0;
+
+        std::vector<uint64_t> loads(count);
+        uint64_t total = 0;
+
+        for (size_t idx = 0; idx < count; ++idx) {
+            loads[idx] = workers_[idx]->busy.exchange(0, std::memory_order_relaxed);
+            total += loads[idx];
+        }
+
+        std::lock_guard lock(placementMutex_);
+
+        // 每个窗口都要清零, 否则下一次的统计会混入旧数据
+        // 顺便清理已经销毁的Placement
+        std::vector<std::pair<uint64_t, PlacementHandle>> all;
+        std::erase_if(placements_, [&all](const auto &weak) {
+            auto placement = weak.lock();
+            if (!placement)
+                return true;
+
+            const auto busy = placement->busy.exchange(0, std::memory_order_relaxed);
+            all.emplace_back(busy, std::move(placement));
+            return false;
+        });
+        placementLimit_ = std::max(kMinPlacementLimit, placements_.size() * 2);
+
+        // 没有耗时数据时按积压的固定任务数选择
+        auto metric = loads;
+        if (total == 0) {
+            for (size_t idx = 0; idx < count; ++idx) {
+                metric[idx] = workers_[idx]->pinnedCount.load(std::memory_order_relaxed);
+            }
+        }
+
+        const auto hot = static_cast<size_t>(std::ranges::max_element(metric) - metric.begin());
+        const auto cold = static_cast<size_t>(std::ranges::min_element(metric) - metric.begin());
+
+        if (hot == cold)
+            return 0;
+
+        const auto average = static_cast<double>(total) / static_cast<double>(count);
+        const bool overloaded = total > 0 && static_cast<double>(loads[hot]) > average * ratio;
+        const bool congested = backlog > 0 && workers_[hot]->pinnedCount.load(std::memory_order_relaxed) > backlog;
+
+        if (!overloaded && !congested)
+            return 0;
+
+        std::vector<std::pair<uint64_t, PlacementHandle>> candidates;
+        for (auto &[busy, placement] : all) {
+            if (placement->worker.load(std::memory_order_relaxed) == static_cast<int>(hot)) {
+                candidates.emplace_back(busy, std::move(placement));
+            }
+        }
+
+        // 只剩一个热点Actor时迁移也无济于事
+        if (candidates.size() < 2)
+            return 0;
+
+        std::ranges::sort(candidates, std::greater{}, [](const auto &node) {
+            return node.first;
+        });
+
+        auto hotLoad = loads[hot];
+        auto coldLoad = loads[cold];
+        size_t moved = 0;
+
+        auto migrate = [&](const PlacementHandle &placement) {
+            placement->worker.store(static_cast<int>(cold), std::memory_order_release);
+            ++moved;
+        };
+
+        // 从负载最高的开始, 只迁移能够缩小两者差距的Placement
+        if (overloaded) {
+            for (const auto &[busy, placement] : candidates) {
+                if (hotLoad <= coldLoad)
+                    break;
+
+                if (busy == 0 || busy > (hotLoad - coldLoad) / 2)
+                    continue;
+
+                migrate(placement);
+
+                hotLoad -= busy;
+                coldLoad += busy;
+            }
+        }
+
+        // 只有积压时无法区分来源, 把最忙的Actor之外负载最高的一个移走, 避免它继续排在热点后面
+        if (moved == 0 && congested) {
+            migrate(candidates[1].second);
+        }
+
+        if (moved > 0) {
+            SPDLOG_INFO("ActorScheduler migrated {} actor(s) from worker[{}] to worker[{}]", moved, hot, cold);
+        }
+
+        return moved;
+    }
+
+    size_t ActorScheduler::size() const {
+        return workers_.size();
+    }
+
+    void ActorScheduler::post(TaskHandle &&task, int worker) {
+        if (stopped_.load(std::memory_order_acquire))
+            return;
+
+        // 投递时才读取Placement, 迁移之后的任务直接进入新线程
+        if (task->placement) {
+            worker = task->placement->worker.load(std::memory_order_acquire);
+        }
+
+        if (worker >= 0) {
+            auto &target = *workers_[worker];
+            {
+                std::lock_guard lock(target.mutex);
+                target.pinned.emplace_back(std::move(task));
+            }
+            target.pinnedCount.fetch_add(1, std::memory_order_seq_cst);
+        } else if (kCurrentScheduler == this) {
+            // 工作线程内产生的任务优先放入本地队列 保持缓存局部性
+            auto &local = *workers_[kCurrentWorker];
+            {
+                std::lock_guard lock(local.mutex);
+                local.queue.emplace_back(std::move(task));
+            }
+            pending_.fetch_add(1, std::memory_order_seq_cst);
+        } else {
+            // IO线程, 定时器等外部投递轮流进入各线程的运行队列, 由空闲线程窃取平衡
+            auto &target = *workers_[nextWorker_.fetch_add(1, std::memory_order_relaxed) % workers_.size()];
+            {
+                std::lock_guard lock(target.mutex);
+                target.queue.emplace_back(std::move(task));
+            }
+            pending_.fetch_add(1, std::memory_order_seq_cst);
+        }
+
+        if (idle_.load(std::memory_order_seq_cst) > 0) {
+            this->wakeUp(worker);
+        }
+    }
+
+    void ActorScheduler::wakeUp(const int worker) {
+        std::lock_guard lock(sleepMutex_);
+
+        auto notify = [this](Worker &target) {
+            target.sleeping = false;
+            idle_.fetch_sub(1, std::memory_order_seq_cst);
+            target.cond.notify_one();
+        };
+
+        // 固定任务只能由目标线程执行
+        if (worker >= 0) {
+            if (auto &target = *workers_[worker]; target.sleeping) {
+                notify(target);
+            }
+            return;
+        }
+
+        for (const auto &target : workers_) {
+            if (target->sleeping) {
+                notify(*target);
+                return;
+            }
+        }
+    }
+
+    void ActorScheduler::run(const size_t index) {
+        kCurrentScheduler = this;
+        kCurrentWorker = index;
+
+        auto &worker = *workers_[index];
+
+        while (!stopped_.load(std::memory_order_acquire)) {
+            if (auto task = this->acquire(index)) {
+                const auto begin = task->placement ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+
+                try {
+                    task->run();
+                } catch (std::exception &e) {
+                    SPDLOG_ERROR("ActorScheduler worker[{}] exception: {}", index, e.what());
+                }
+
+                // 只统计固定任务, 可窃取的任务本身就会在线程间流动
+                if (task->placement) {
+                    const auto elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - begin).count());
+
+                    task->placement->busy.fetch_add(elapsed, std::memory_order_relaxed);
+                    worker.busy.fetch_add(elapsed, std::memory_order_relaxed);
+                }
+
+                continue;
+            }
+
+            std::unique_lock lock(sleepMutex_);
+
+            worker.sleeping = true;
+            idle_.fetch_add(1, std::memory_order_seq_cst);
+
+            worker.cond.wait(lock, [this, &worker] {
+                return !worker.sleeping
+                    || stopped_.load(std::memory_order_acquire)
+                    || pending_.load(std::memory_order_seq_cst) > 0
+                    || worker.pinnedCount.load(std::memory_order_seq_cst) > 0;
+            });
+
+            // 不是被wakeUp唤醒时需要自行恢复状态
+            if (worker.sleeping) {
+                worker.sleeping = false;
+                idle_.fetch_sub(1, std::memory_order_seq_cst);
+            }
+        }
+
+        kCurrentScheduler = nullptr;
+    }
+
+    ActorScheduler::TaskHandle ActorScheduler::acquire(const size_t index) {
+        // 本地队列
+        {
+            auto &worker = *workers_[index];
+            std::lock_guard lock(worker.mutex);
+
+            if (!worker.pinned.empty()) {
+                auto task = std::move(worker.pinned.front());
+                worker.pinned.pop_front();
+                worker.pinnedCount.fetch_sub(1, std::memory_order_seq_cst);
+                return task;
+            }
+
+            if (!worker.queue.empty()) {
+                auto task = std::move(worker.queue.front());
+                worker.queue.pop_front();
+                pending_.fetch_sub(1, std::memory_order_seq_cst);
+                return task;
+            }
+        }
+
+        return this->steal(index);
+    }
+
+    ActorScheduler::TaskHandle ActorScheduler::steal(const size_t index) {
+        const auto count = workers_.size();
+
+        for (size_t offset = 1; offset < count; ++offset) {
+            auto &victim = *workers_[(index + offset) % count];
+            std::vector<TaskHandle> stolen;
+
+            {
+                std::lock_guard lock(victim.mutex);
+                if (victim.queue.empty())
+                    continue;
+
+                // 一次窃取一半 减少反复窃取的次数, 固定任务不参与窃取
+                const auto num = (victim.queue.size() + 1) / 2;
+                stolen.reserve(num);
+
+                for (size_t idx = 0; idx < num; ++idx) {
+                    stolen.emplace_back(std::move(victim.queue.front()));
+                    victim.queue.pop_front();
+                }
+            }
+
+            // 只有取出的第一个任务离开了队列
+            pending_.fetch_sub(1, std::memory_order_seq_cst);
+
+            if (stolen.size() > 1) {
+                auto &worker = *workers_[index];
+                std::lock_guard lock(worker.mutex);
+                for (auto it = stolen.begin() + 1; it != stolen.end(); ++it) {
+                    worker.queue.emplace_back(std::move(*it));
+                }
+            }
+
+            return std::move(stolen.front());
+        }
+
+        return nullptr;
+    }
+}
@@ -0,0 +1,309 @@
+#include "scheduler/Watchdog.h"
+
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#if defined(__linux__)
+#include <execinfo.h>
+#include <pthread.h>
+#include <csignal>
+#include <cerrno>
+#include <cstdlib>
+#endif
+
+
+namespace uranus::actor {
+
+    namespace {
+
+        constexpr int kMaxFrames = 64;
+
+        /// 每个工作线程一个, 只由所属线程写入, 看门狗按seqlock的方式读取
+        struct WatchdogSlot {
+            // 奇数表示正在处理信封
+            std::atomic<uint64_t> seq{0};
+
+            std::atomic<int64_t> actor{0};
+            std::atomic<int> type{0};
+            std::atomic<int64_t> package{0};
+            std::atomic<int64_t> start{0};
+
+            std::atomic_bool alive{true};
+
+            // 以下只由看门狗线程访问
+            uint64_t reported = 0;
+
+#if defined(__linux__)
+            // 线程退出时持有它修改alive, 看门狗持有它检查alive并发送信号,
+            // 保证pthread_kill的目标线程一定还没有退出
+            std::mutex signalMutex;
+
+            pthread_t handle{};
+            void *frames[kMaxFrames]{};
+            std::atomic<int> frameCount{-1};
+#endif
+        };
+
+        struct SlotHolder {
+            std::shared_ptr<WatchdogSlot> slot;
+
+            ~SlotHolder();
+        };
+
+        std::atomic<int> kActive{0};
+
+        std::mutex kSlotMutex;
+        std::vector<std::shared_ptr<WatchdogSlot>> kSlots;
+
+        thread_local SlotHolder kHolder;
+
+        // 信号处理函数中只访问平凡的thread_local
+        thread_local WatchdogSlot *kCurrentSlot = nullptr;
+
+        SlotHolder::~SlotHolder() {
+            if (!slot)
+                return;
+
+#if defined(__linux__)
+            std::lock_guard lock(slot->signalMutex);
+#endif
+            slot->alive.store(false, std::memory_order_release);
+
+            // 之后到达的信号不再写入即将释放的槽位
+            kCurrentSlot = nullptr;
+        }
+
+        int64_t ToNanoseconds(const SteadyTimePoint point) {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(point.time_since_epoch()).count();
+        }
+
+        WatchdogSlot *AcquireSlot() {
+            if (kCurrentSlot != nullptr)
+                return kCurrentSlot;
+
+            auto slot = std::make_shared<WatchdogSlot>();
+#if defined(__linux__)
+            slot->handle = pthread_self();
+#endif
+
+            {
+                std::lock_guard lock(kSlotMutex);
+                kSlots.emplace_back(slot);
+            }
+
+            kHolder.slot = slot;
+            kCurrentSlot = slot.get();
+
+            return kCurrentSlot;
+        }
+
+#if defined(__linux__)
+        const int kBacktraceSignal = SIGRTMIN + 7;
+
+        void OnBacktraceSignal(int) {
+            if (auto *slot = kCurrentSlot) {
+                const auto saved = errno;
+                slot->frameCount.store(::backtrace(slot->frames, kMaxFrames), std::memory_order_release);
+                errno = saved;
+            }
+        }
+
+        void CaptureBacktrace(WatchdogSlot &slot, const uint64_t seq) {
+            slot.frameCount.store(-1, std::memory_order_release);
+
+            {
+                std::lock_guard lock(slot.signalMutex);
+
+                // 线程已经退出时handle可能已被复用, 不能再发送信号
+                if (!slot.alive.load(std::memory_order_acquire))
+                    return;
+
+                if (pthread_kill(slot.handle, kBacktraceSignal) != 0)
+                    return;
+            }
+
+            // 等待目标线程在信号处理函数中写入调用栈
+            int count = -1;
+            for (int idx = 0; idx < 100 && count < 0; ++idx) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                count = slot.frameCount.load(std::memory_order_acquire);
+            }
+
+            // 抓取期间已经处理完成, 调用栈不再对应这次慢处理
+            if (count <= 0 || slot.seq.load(std::memory_order_acquire) != seq)
+                return;
+
+            char **symbols = ::backtrace_symbols(slot.frames, count);
+            if (symbols == nullptr)
+                return;
+
+            for (int idx = 0; idx < count; ++idx) {
+                SPDLOG_WARN("    #{} {}", idx, symbols[idx]);
+            }
+
+            std::free(symbols);
+        }
+#endif
+    }
+
+    Watchdog::Watchdog(const SteadyDuration budget, const bool backtrace)
+        : budget_(budget),
+          backtrace_(backtrace),
+          running_(false) {
+    }
+
+    Watchdog::~Watchdog() {
+        stop();
+    }
+
+    void Watchdog::start() {
+        {
+            std::lock_guard lock(mutex_);
+            if (running_)
+                return;
+
+            running_ = true;
+        }
+
+#if defined(__linux__)
+        if (backtrace_) {
+            // 提前加载backtrace依赖的库, 避免在信号处理函数中首次加载
+            void *dummy[1];
+            ::backtrace(dummy, 1);
+
+            struct sigaction action{};
+            action.sa_handler = &OnBacktraceSignal;
+            action.sa_flags = SA_RESTART;
+            sigemptyset(&action.sa_mask);
+
+            if (sigaction(kBacktraceSignal, &action, nullptr) != 0) {
+                SPDLOG_WARN("Watchdog failed to install the backtrace signal handler");
+                backtrace_ = false;
+            }
+        }
+#else
+        if (backtrace_) {
+            SPDLOG_WARN("Watchdog backtrace is not supported on this platform");
+            backtrace_ = false;
+        }
+#endif
+
+        kActive.fetch_add(1, std::memory_order_release);
+
+        thread_ = std::thread([this] {
+            this->run();
+        });
+    }
+
+    void Watchdog::stop() {
+        {
+            std::lock_guard lock(mutex_);
+            if (!running_)
+                return;
+
+            running_ = false;
+        }
+
+        cond_.notify_all();
+
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+
+        kActive.fetch_sub(1, std::memory_order_release);
+    }
+
+    bool Watchdog::isActive() {
+        return kActive.load(std::memory_order_relaxed) > 0;
+    }
+
+    void Watchdog::begin(const int64_t actor, const int type, const int64_t package, const SteadyTimePoint now) {
+        auto *slot = AcquireSlot();
+        auto seq = slot->seq.load(std::memory_order_relaxed);
+
+        // 上一次处理因异常没有调用end()
+        if ((seq & 1) != 0) {
+            slot->seq.store(++seq, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        slot->actor.store(actor, std::memory_order_relaxed);
+        slot->type.store(type, std::memory_order_relaxed);
+        slot->package.store(package, std::memory_order_relaxed);
+        slot->start.store(ToNanoseconds(now), std::memory_order_relaxed);
+
+        slot->seq.store(seq + 1, std::memory_order_release);
+    }
+
+    void Watchdog::end() {
+        auto *slot = kCurrentSlot;
+        if (slot == nullptr)
+            return;
+
+        if (const auto seq = slot->seq.load(std::memory_order_relaxed); (seq & 1) != 0) {
+            slot->seq.store(seq + 1, std::memory_order_release);
+        }
+    }
+
+    void Watchdog::run() {
+        // 采样间隔为预算的四分之一, 报告的延迟不超过预算的1.25倍
+        const auto interval = std::max<SteadyDuration>(budget_ / 4, std::chrono::milliseconds(1));
+        const auto budget = std::chrono::duration_cast<std::chrono::nanoseconds>(budget_).count();
+
+        std::unique_lock lock(mutex_);
+
+        while (running_) {
+            cond_.wait_for(lock, interval, [this] {
+                return !running_;
+            });
+
+            if (!running_)
+                break;
+
+            std::vector<std::shared_ptr<WatchdogSlot>> slots;
+
+            {
+                std::lock_guard guard(kSlotMutex);
+                std::erase_if(kSlots, [](const auto &slot) {
+                    return !slot->alive.load(std::memory_order_acquire);
+                });
+                slots = kSlots;
+            }
+
+            const auto now = ToNanoseconds(std::chrono::steady_clock::now());
+
+            for (const auto &slot : slots) {
+                const auto seq = slot->seq.load(std::memory_order_acquire);
+                if ((seq & 1) == 0 || slot->reported == seq)
+                    continue;
+
+                const auto actor = slot->actor.load(std::memory_order_relaxed);
+                const auto type = slot->type.load(std::memory_order_relaxed);
+                const auto package = slot->package.load(std::memory_order_relaxed);
+                const auto start = slot->start.load(std::memory_order_relaxed);
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot->seq.load(std::memory_order_relaxed) != seq)
+                    continue;
+
+                const auto elapsed = now - start;
+                if (elapsed < budget)
+                    continue;
+
+                slot->reported = seq;
+
+                SPDLOG_WARN("Watchdog: actor[{}] blocked its worker for {} ms, envelope type: {}, package id: {}",
+                    actor, elapsed / 1000000, type, package);
+
+#if defined(__linux__)
+                if (backtrace_) {
+                    CaptureBacktrace(*slot, seq);
+                }
+#endif
+            }
+        }
+    }
+}
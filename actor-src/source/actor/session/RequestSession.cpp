@@ -1,80 +1,22 @@
-﻿#include "session/RequestSession.h"
-#include "session/SessionManager.h"
-#include "BaseActorContext.h"
-
-#include <asio/bind_allocator.hpp>
-#include <asio/detached.hpp>
-#include <asio/co_spawn.hpp>
+#include "session/RequestSession.h"
 
 
 namespace uranus::actor {
 
-    using asio::detached;
-    using asio::co_spawn;
-    using asio::awaitable;
-
-    static void DispatchResponse(SessionHandler &&handler, PackageHandle &&res) {
-        const auto work = asio::make_work_guard(handler);
-        const auto alloc = asio::get_associated_allocator(handler, asio::recycling_allocator<void>());
-
-        asio::dispatch(
-            work.get_executor(),
-            asio::bind_allocator(
-                alloc,
-                [handler = std::move(handler), response = std::move(res)]() mutable {
-                    std::move(handler)(std::move(response));
-                }
-            )
-        );
+    int64_t RequestSession::makeId(const uint32_t index, const uint32_t generation) {
+        return (static_cast<int64_t>(generation) << 32) | index;
     }
 
-    RequestSession::RequestSession(const shared_ptr<BaseActorContext> &owner, SessionHandler &&handler, const int64_t id)
-        : exec_(owner->executor()),
-          id_(id),
-          handler_(std::move(handler)),
-          timer_(exec_),
-          owner_(owner) {
-        // 发起超时等待
-        co_spawn(exec_, [self = shared_from_this()]() mutable -> awaitable<void> {
-            try {
-                self->timer_.expires_after(std::chrono::seconds(5));
-
-                // 即使返回error_code也需要唤醒协程 所以直接无论如何都唤醒
-                co_await self->timer_.async_wait();
-
-                // 超时返回空指针
-                if (!self->completed_.test_and_set(std::memory_order_acquire)) {
-                    DispatchResponse(std::move(self->handler_), nullptr);
-                    if (const auto temp = self->owner_.lock()) {
-                        temp->getSessionManager().removeOnComplete(self->id_);
-                    }
-                }
-            } catch (std::exception &e) {
-                if (const auto temp = self->owner_.lock()) {
-                    temp->onException(e);
-                }
-            }
-        }, detached);
-
-    }
-
-    RequestSession::~RequestSession() {
-        this->cancel();
+    uint32_t RequestSession::indexOf(const int64_t id) {
+        return static_cast<uint32_t>(id & 0xFFFFFFFF);
     }
 
-    void RequestSession::dispatch(PackageHandle &&res) {
-        if (!completed_.test_and_set(std::memory_order_acquire)) {
-            // 因为completed_已经被设置 所以timer.async_wait下面的分支不会执行
-            timer_.cancel();
-
-            DispatchResponse(std::move(handler_), std::move(res));
-            if (const auto owner = owner_.lock()) {
-                owner->getSessionManager().removeOnComplete(id_);
-            }
-        }
+    uint32_t RequestSession::generationOf(const int64_t id) {
+        return static_cast<uint32_t>(id >> 32);
     }
 
-    void RequestSession::cancel() {
-        this->dispatch(nullptr);
+    uint32_t RequestSession::nextGeneration(const uint32_t generation) {
+        const auto next = (generation + 1) & 0x7FFFFFFF;
+        return next == 0 ? 1 : next;
     }
 }
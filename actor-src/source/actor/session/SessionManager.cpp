@@ -1,69 +1,200 @@
 #include "session/SessionManager.h"
-#include "session/RequestSession.h"
 #include "BaseActorContext.h"
 
 #include <asio/bind_allocator.hpp>
-#include <ranges>
+#include <asio/recycling_allocator.hpp>
+#include <algorithm>
 
 
 namespace uranus::actor {
 
+    static void DispatchResponse(SessionHandler &&handler, PackageHandle &&res) {
+        const auto work = asio::make_work_guard(handler);
+        const auto alloc = asio::get_associated_allocator(handler, asio::recycling_allocator<void>());
+
+        asio::dispatch(
+            work.get_executor(),
+            asio::bind_allocator(
+                alloc,
+                [handler = std::move(handler), response = std::move(res)]() mutable {
+                    std::move(handler)(std::move(response));
+                }
+            )
+        );
+    }
+
+    // 最小堆比较器
+    static bool DeadlineGreater(const std::pair<SteadyTimePoint, int64_t> &lhs, const std::pair<SteadyTimePoint, int64_t> &rhs) {
+        return lhs.first > rhs.first;
+    }
+
     SessionManager::SessionManager(BaseActorContext &ctx)
-        : ctx_(ctx) {
+        : ctx_(ctx),
+          freeHead_(RequestSession::kInvalidIndex),
+          active_(0),
+          sweeper_(ctx.executor()),
+          armed_(false) {
     }
 
     SessionManager::~SessionManager() {
     }
 
-    int64_t SessionManager::pushSession(SessionHandler &&handler) {
-        if (ctx_.isRunning()) {
-            if (const auto id = alloc_.allocate(); !sessions_.contains(id)) {
-                auto sess = make_shared<RequestSession>(ctx_.shared_from_this(), std::move(handler), id);
-                sessions_.emplace(id, sess);
-                return id;
-            }
+    int64_t SessionManager::pushSession(SessionHandler &&handler, const SteadyTimePoint deadline) {
+        if (!ctx_.isRunning()) {
+            DispatchResponse(std::move(handler), nullptr);
+            return -1;
         }
 
-        const auto work = asio::make_work_guard(handler);
-        const auto alloc = asio::get_associated_allocator(handler, asio::recycling_allocator<void>());
-        asio::dispatch(
-            work.get_executor(),
-            asio::bind_allocator(alloc, [handler = std::move(handler)]() mutable {
-                std::move(handler)(nullptr);
-            })
-        );
+        uint32_t index;
 
-        return -1;
+        if (freeHead_ != RequestSession::kInvalidIndex) {
+            index = freeHead_;
+            freeHead_ = slots_[index].nextFree;
+        } else {
+            index = static_cast<uint32_t>(slots_.size());
+            slots_.emplace_back();
+        }
+
+        auto &slot = slots_[index];
+
+        slot.handler = std::move(handler);
+        slot.deadline = deadline == SteadyTimePoint{}
+            ? std::chrono::steady_clock::now() + kDefaultTimeout
+            : deadline;
+        slot.nextFree = RequestSession::kInvalidIndex;
+        slot.active = true;
+
+        ++active_;
+
+        const auto id = RequestSession::makeId(index, slot.generation);
+
+        deadlines_.emplace_back(slot.deadline, id);
+        std::ranges::push_heap(deadlines_, DeadlineGreater);
+
+        this->arm(slot.deadline);
+        return id;
     }
 
     void SessionManager::dispatch(const int64_t id, PackageHandle &&res) {
-        const auto iter = sessions_.find(id);
-        if (iter == sessions_.end())
-            return;
-
-        iter->second->dispatch(std::move(res));
+        this->complete(id, std::move(res));
     }
 
     void SessionManager::cancel(const int64_t id) {
-        if (const auto iter = sessions_.find(id); iter != sessions_.end()) {
-            iter->second->cancel();
-            return;
+        this->complete(id, nullptr);
+    }
+
+    void SessionManager::cancelAll() {
+        for (auto &slot : slots_) {
+            if (slot.active) {
+                slot.active = false;
+                DispatchResponse(std::move(slot.handler), nullptr);
+            }
         }
 
-        sessions_.erase(id);
+        slots_.clear();
+        deadlines_.clear();
+
+        freeHead_ = RequestSession::kInvalidIndex;
+        active_ = 0;
+
+        armed_ = false;
+        sweeper_.cancel();
     }
 
-    void SessionManager::cancelAll() {
-        for (const auto &sess: sessions_ | std::views::values) {
-            sess->cancel();
+    size_t SessionManager::size() const {
+        return active_;
+    }
+
+    RequestSession *SessionManager::find(const int64_t id) {
+        if (id <= 0)
+            return nullptr;
+
+        const auto index = RequestSession::indexOf(id);
+        if (index >= slots_.size())
+            return nullptr;
+
+        auto &slot = slots_[index];
+        if (!slot.active || slot.generation != RequestSession::generationOf(id))
+            return nullptr;
+
+        return &slot;
+    }
+
+    void SessionManager::complete(const int64_t id, PackageHandle &&res) {
+        auto *slot = this->find(id);
+        if (slot == nullptr)
+            return;
+
+        auto handler = std::move(slot->handler);
+
+        // 代数加一使旧的id失效
+        slot->active = false;
+        slot->generation = RequestSession::nextGeneration(slot->generation);
+
+        const auto index = RequestSession::indexOf(id);
+        slot->nextFree = freeHead_;
+        freeHead_ = index;
+
+        --active_;
+
+        // 每个未完成的会话在堆中恰好有一个节点, 其余都是已完成会话留下的
+        if (deadlines_.size() >= kCompactThreshold && (deadlines_.size() - active_) * 2 > deadlines_.size()) {
+            this->compact();
         }
-        sessions_.clear();
+
+        DispatchResponse(std::move(handler), std::move(res));
     }
 
-    void SessionManager::removeOnComplete(const int64_t id) {
-        if (!ctx_.isRunning())
+    void SessionManager::arm(const SteadyTimePoint deadline) {
+        if (armed_ && deadline >= armedAt_)
             return;
 
-        sessions_.erase(id);
+        armed_ = true;
+        armedAt_ = deadline;
+
+        // 重新设置到期时间会以operation_aborted取消之前的等待
+        sweeper_.expires_at(deadline);
+        sweeper_.async_wait([this, weak = ctx_.weak_from_this()](const std::error_code ec) {
+            if (ec == asio::error::operation_aborted)
+                return;
+
+            if (const auto owner = weak.lock(); owner && owner->isRunning()) {
+                this->sweep();
+            }
+        });
+    }
+
+    void SessionManager::sweep() {
+        armed_ = false;
+
+        const auto now = std::chrono::steady_clock::now();
+
+        while (!deadlines_.empty() && deadlines_.front().first <= now) {
+            std::ranges::pop_heap(deadlines_, DeadlineGreater);
+            const auto id = deadlines_.back().second;
+            deadlines_.pop_back();
+
+            // 已经完成的会话在这里被丢弃
+            if (const auto *slot = this->find(id); slot && slot->deadline <= now) {
+                this->complete(id, nullptr);
+            }
+        }
+
+        if (!deadlines_.empty()) {
+            this->arm(deadlines_.front().first);
+        }
+    }
+
+    void SessionManager::compact() {
+        deadlines_.clear();
+
+        for (uint32_t index = 0; index < slots_.size(); ++index) {
+            if (const auto &slot = slots_[index]; slot.active) {
+                deadlines_.emplace_back(slot.deadline, RequestSession::makeId(index, slot.generation));
+            }
+        }
+
+        // 定时器仍按之前最早的截止时间触发, 提前触发时sweep()重新设置
+        std::ranges::make_heap(deadlines_, DeadlineGreater);
     }
 }
@@ -0,0 +1,162 @@
+#include "timer/HierarchicalWheel.h"
+
+#include <algorithm>
+
+
+namespace uranus::actor {
+
+    HierarchicalWheel::HierarchicalWheel()
+        : root_{},
+          levels_{},
+          current_(0),
+          count_(0) {
+    }
+
+    HierarchicalWheel::~HierarchicalWheel() {
+    }
+
+    void HierarchicalWheel::insert(WheelNode *node) {
+        node->expire_ = std::max(node->expire_, current_ + 1);
+        this->place(node);
+        ++count_;
+    }
+
+    void HierarchicalWheel::remove(WheelNode *node) {
+        if (node->slot_ == nullptr)
+            return;
+
+        unlink(node);
+        --count_;
+    }
+
+    void HierarchicalWheel::advance(const int64_t now, std::vector<WheelNode *> &expired) {
+        while (current_ < now && count_ > 0) {
+            ++current_;
+
+            // 低层转完一圈时把高一层的对应槽下放
+            if ((current_ & kRootMask) == 0) {
+                for (int64_t level = 0; level < kLevels; ++level) {
+                    const auto index = (current_ >> (kRootBits + kLevelBits * level)) & kLevelMask;
+                    this->cascade(level, index);
+
+                    if (index != 0)
+                        break;
+                }
+            }
+
+            auto &slot = root_[current_ & kRootMask];
+            while (slot != nullptr) {
+                auto *node = slot;
+                unlink(node);
+                --count_;
+
+                expired.emplace_back(node);
+            }
+        }
+
+        // 没有节点时直接追上当前时刻
+        if (count_ == 0 && current_ < now) {
+            current_ = now;
+        }
+    }
+
+    void HierarchicalWheel::clear(std::vector<WheelNode *> &nodes) {
+        auto lClear = [&nodes](WheelNode *&head) {
+            while (head != nullptr) {
+                auto *node = head;
+                unlink(node);
+                nodes.emplace_back(node);
+            }
+        };
+
+        for (auto &head : root_)
+            lClear(head);
+
+        for (auto &level : levels_) {
+            for (auto &head : level)
+                lClear(head);
+        }
+
+        count_ = 0;
+    }
+
+    void HierarchicalWheel::align(const int64_t tick) {
+        if (count_ == 0) {
+            current_ = tick;
+        }
+    }
+
+    int64_t HierarchicalWheel::current() const {
+        return current_;
+    }
+
+    std::size_t HierarchicalWheel::size() const {
+        return count_;
+    }
+
+    bool HierarchicalWheel::linked(const WheelNode *node) {
+        return node->slot_ != nullptr;
+    }
+
+    void HierarchicalWheel::place(WheelNode *node) {
+        const auto expire = node->expire_;
+        const auto delta = expire - current_;
+
+        if (delta < kRootSize) {
+            link(&root_[expire & kRootMask], node);
+            return;
+        }
+
+        for (int64_t level = 0; level < kLevels; ++level) {
+            const auto shift = kRootBits + kLevelBits * level;
+            if (delta < (int64_t(1) << (shift + kLevelBits)) || level == kLevels - 1) {
+                // 超出范围的放在最高层当前槽之前 下次级联时重新计算
+                const auto target = delta < kMaxSpan ? expire : current_ + kMaxSpan - 1;
+                link(&levels_[level][(target >> shift) & kLevelMask], node);
+                return;
+            }
+        }
+    }
+
+    void HierarchicalWheel::link(WheelNode **slot, WheelNode *node) {
+        node->slot_ = slot;
+        node->prev_ = nullptr;
+        node->next_ = *slot;
+
+        if (*slot != nullptr)
+            (*slot)->prev_ = node;
+
+        *slot = node;
+    }
+
+    void HierarchicalWheel::unlink(WheelNode *node) {
+        if (node->prev_ != nullptr) {
+            node->prev_->next_ = node->next_;
+        } else {
+            *node->slot_ = node->next_;
+        }
+
+        if (node->next_ != nullptr)
+            node->next_->prev_ = node->prev_;
+
+        node->slot_ = nullptr;
+        node->prev_ = nullptr;
+        node->next_ = nullptr;
+    }
+
+    void HierarchicalWheel::cascade(const int64_t level, const int64_t index) {
+        auto *head = levels_[level][index];
+        levels_[level][index] = nullptr;
+
+        while (head != nullptr) {
+            auto *node = head;
+            head = node->next_;
+
+            node->slot_ = nullptr;
+            node->prev_ = nullptr;
+            node->next_ = nullptr;
+
+            this->place(node);
+        }
+    }
+}
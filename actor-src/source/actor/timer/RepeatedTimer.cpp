@@ -1,4 +1,5 @@
 #include "timer/RepeatedTimer.h"
+#include "timer/TimingWheel.h"
 #include "BaseActorContext.h"
 
 #include <asio/co_spawn.hpp>
@@ -14,9 +15,13 @@ namespace uranus::actor {
         : exec_(owner->executor()),
           id_(id),
           owner_(owner),
-          innerTimer_(exec_),
           delay_(0),
-          rate_(0) {
+          rate_(0),
+          wheel_(nullptr),
+          epoch_(owner->getTimerManager().epoch()),
+          interval_(0),
+          prevManaged_(nullptr),
+          nextManaged_(nullptr) {
     }
 
     RepeatedTimer::~RepeatedTimer() {
@@ -46,6 +51,12 @@ namespace uranus::actor {
         rate_ = rate;
     }
 
+    void RepeatedTimer::setWheel(TimingWheel *wheel) {
+        if (running_.test(std::memory_order_acquire))
+            return;
+        wheel_ = wheel;
+    }
+
     void RepeatedTimer::start() {
         if (completed_.test(std::memory_order_acquire))
             return;
@@ -53,6 +64,24 @@ namespace uranus::actor {
         if (running_.test_and_set(std::memory_order_acq_rel))
             return;
 
+        if (wheel_ != nullptr) {
+            auto point = std::chrono::steady_clock::now();
+
+            if (delay_ > SteadyDuration::zero()) {
+                point += delay_;
+            } else if (point_ >= point) {
+                point = point_;
+            }
+
+            if (wheel_->schedule(shared_from_this(), point, rate_))
+                return;
+
+            // 时间轮已经停止 退回到自己的定时器
+            wheel_ = nullptr;
+        }
+
+        innerTimer_.emplace(exec_);
+
         co_spawn(exec_, [self = shared_from_this()]()-> awaitable<void> {
             try {
                 if (self->owner_.expired()) {
@@ -80,8 +109,8 @@ namespace uranus::actor {
 
                 // The first await
                 {
-                    self->innerTimer_.expires_at(point);
-                    const auto [ec] = co_await self->innerTimer_.async_wait();
+                    self->innerTimer_->expires_at(point);
+                    const auto [ec] = co_await self->innerTimer_->async_wait();
 
                     const auto temp = self->owner_.lock();
                     if (temp == nullptr) {
@@ -97,7 +126,9 @@ namespace uranus::actor {
                         co_return;
                     }
 
-                    auto evl = Envelope::makeCallback(self->task_);
+                    auto evl = Envelope::makeCallback([self](BaseActor *actor) {
+                        self->task_(actor);
+                    });
                     temp->pushEnvelope(std::move(evl));
                 }
 
@@ -105,9 +136,9 @@ namespace uranus::actor {
                 if (self->rate_ > SteadyDuration::zero()) {
                     while (true) {
                         point += self->rate_;
-                        self->innerTimer_.expires_at(point);
+                        self->innerTimer_->expires_at(point);
 
-                        const auto [ec] = co_await self->innerTimer_.async_wait();
+                        const auto [ec] = co_await self->innerTimer_->async_wait();
 
                         const auto temp = self->owner_.lock();
                         if (temp == nullptr) {
@@ -122,7 +153,9 @@ namespace uranus::actor {
                             break;
                         }
 
-                        auto evl = Envelope::makeCallback(self->task_);
+                        auto evl = Envelope::makeCallback([self](BaseActor *actor) {
+                            self->task_(actor);
+                        });
                         temp->pushEnvelope(std::move(evl));
                     }
                 }
@@ -137,9 +170,20 @@ namespace uranus::actor {
     }
 
     void RepeatedTimer::cancel() {
+        cancelled_.test_and_set(std::memory_order_acq_rel);
+
         if (completed_.test_and_set(std::memory_order_acq_rel))
             return;
 
+        // 从时间轮中摘下, 再回到Actor线程移出TimerManager的链表
+        if (wheel_ != nullptr) {
+            wheel_->cancel(this);
+            asio::dispatch(exec_, [self = shared_from_this()] {
+                self->release();
+            });
+            return;
+        }
+
         if (!running_.test_and_set(std::memory_order_acq_rel)) {
             asio::dispatch(exec_, [self = shared_from_this()]() mutable {
                 if (const auto temp = self->owner_.lock(); temp && self->id_ > 0) {
@@ -149,6 +193,22 @@ namespace uranus::actor {
             return;
         }
 
-        innerTimer_.cancel();
+        if (innerTimer_.has_value()) {
+            innerTimer_->cancel();
+        }
+    }
+
+    bool RepeatedTimer::expired() const {
+        if (cancelled_.test(std::memory_order_acquire))
+            return true;
+
+        const auto owner = owner_.lock();
+        return owner == nullptr || owner->getTimerManager().epoch() != epoch_;
+    }
+
+    void RepeatedTimer::release() {
+        if (const auto owner = owner_.lock()) {
+            owner->getTimerManager().unlink(this);
+        }
     }
 }
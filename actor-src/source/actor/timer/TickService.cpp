@@ -0,0 +1,137 @@
+#include "timer/TickService.h"
+#include "BaseActorContext.h"
+
+#include <base/utils.h>
+#include <asio/co_spawn.hpp>
+#include <asio/detached.hpp>
+#include <asio/dispatch.hpp>
+
+
+namespace uranus::actor {
+
+    using asio::co_spawn;
+    using asio::detached;
+
+    TickService::Shard::Shard(const asio::any_io_executor &exec, const SteadyDuration period)
+        : timer(asio::make_strand(exec)),
+          period(period) {
+    }
+
+    TickService::TickService(asio::any_io_executor exec, const size_t shards)
+        : exec_(std::move(exec)),
+          shardCount_(shards > 0 ? shards : 1),
+          stopped_(false) {
+    }
+
+    TickService::~TickService() {
+        stop();
+    }
+
+    bool TickService::subscribe(const shared_ptr<BaseActorContext> &ctx, const SteadyDuration period) {
+        if (ctx == nullptr || period <= SteadyDuration::zero())
+            return false;
+
+        const auto shard = this->getShard(ctx.get(), period);
+        if (shard == nullptr)
+            return false;
+
+        std::lock_guard lock(shard->mutex);
+        shard->actors.insert_or_assign(ctx.get(), ctx);
+
+        return true;
+    }
+
+    void TickService::unsubscribe(BaseActorContext *ctx, const SteadyDuration period) {
+        if (ctx == nullptr)
+            return;
+
+        ShardHandle shard;
+
+        {
+            std::lock_guard lock(mutex_);
+            const auto iter = shards_.find(period);
+            if (iter == shards_.end())
+                return;
+
+            shard = iter->second[utils::PointerShard(ctx, shardCount_)];
+        }
+
+        std::lock_guard lock(shard->mutex);
+        shard->actors.erase(ctx);
+    }
+
+    void TickService::stop() {
+        std::lock_guard lock(mutex_);
+        if (stopped_)
+            return;
+
+        stopped_ = true;
+
+        for (const auto &[period, list] : shards_) {
+            for (const auto &shard : list) {
+                asio::dispatch(shard->timer.get_executor(), [shard] {
+                    shard->timer.cancel();
+                });
+            }
+        }
+    }
+
+    TickService::ShardHandle TickService::getShard(BaseActorContext *ctx, const SteadyDuration period) {
+        std::lock_guard lock(mutex_);
+        if (stopped_)
+            return nullptr;
+
+        auto iter = shards_.find(period);
+
+        // 首次出现该周期 创建并启动一组分片
+        if (iter == shards_.end()) {
+            std::vector<ShardHandle> list;
+            list.reserve(shardCount_);
+
+            for (size_t idx = 0; idx < shardCount_; ++idx) {
+                auto shard = std::make_shared<Shard>(exec_, period);
+                co_spawn(shard->timer.get_executor(), run(shard), detached);
+                list.emplace_back(std::move(shard));
+            }
+
+            iter = shards_.emplace(period, std::move(list)).first;
+        }
+
+        return iter->second[utils::PointerShard(ctx, shardCount_)];
+    }
+
+    awaitable<void> TickService::run(const ShardHandle shard) {
+        auto point = std::chrono::steady_clock::now();
+        std::vector<shared_ptr<BaseActorContext>> targets;
+
+        while (true) {
+            point += shard->period;
+            shard->timer.expires_at(point);
+
+            if (const auto [ec] = co_await shard->timer.async_wait(); ec)
+                break;
+
+            // 锁内只复制订阅者并清理已销毁的Actor
+            {
+                std::lock_guard lock(shard->mutex);
+
+                std::erase_if(shard->actors, [&targets](const auto &node) {
+                    auto ctx = node.second.lock();
+                    if (ctx == nullptr)
+                        return true;
+
+                    targets.emplace_back(std::move(ctx));
+                    return false;
+                });
+            }
+
+            // 在锁外投递, 订阅和退订不会被整轮扇出阻塞
+            // 与本轮并发退订的Actor可能再收到一次Tick, 与退订前已进入邮箱的Tick一样
+            for (const auto &ctx : targets) {
+                ctx->pushEnvelope(Envelope::makeTickInfo(point, shard->period));
+            }
+
+            targets.clear();
+        }
+    }
+}
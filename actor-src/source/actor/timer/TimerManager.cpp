@@ -2,15 +2,23 @@
 #include "timer/RepeatedTimer.h"
 #include "BaseActorContext.h"
 
+#include <asio/recycling_allocator.hpp>
 #include <ranges>
 
 namespace uranus::actor {
     TimerManager::TimerManager(BaseActorContext &ctx)
-        : ctx_(ctx){
+        : ctx_(ctx),
+          wheel_(nullptr),
+          resolved_(false),
+          wheelTimers_(nullptr),
+          epoch_(0) {
     }
 
     TimerManager::~TimerManager() {
-
+        // 只打断自身引用, 仍在时间轮中的定时器触发时发现Actor已销毁
+        while (wheelTimers_ != nullptr) {
+            this->unlink(wheelTimers_);
+        }
     }
 
     RepeatedTimerHandle TimerManager::createTimer(
@@ -25,16 +33,15 @@ namespace uranus::actor {
         if (timers_.contains(id))
             return { -1, nullptr };
 
-        auto timer = make_shared<RepeatedTimer>(ctx_.shared_from_this(), id);
+        // 控制块和定时器一次分配, 由线程缓存复用
+        const auto timer = std::allocate_shared<RepeatedTimer>(asio::recycling_allocator<RepeatedTimer>(), ctx_.shared_from_this(), id);
 
         timer->setTask(task);
         timer->setDelay(delay);
         timer->setRepeatRate(rate);
+        timer->setWheel(getWheel());
 
-        timers_.emplace(id, timer);
-
-        timer->start();
-        return { id, timer };
+        return this->startTimer(id, timer);
     }
 
     RepeatedTimerHandle TimerManager::createTimerWithTimepoint(
@@ -49,16 +56,15 @@ namespace uranus::actor {
         if (timers_.contains(id))
             return { -1, nullptr };
 
-        auto timer = make_shared<RepeatedTimer>(ctx_.shared_from_this(), id);
+        // 控制块和定时器一次分配, 由线程缓存复用
+        const auto timer = std::allocate_shared<RepeatedTimer>(asio::recycling_allocator<RepeatedTimer>(), ctx_.shared_from_this(), id);
 
         timer->setTask(task);
         timer->setTimePoint(point);
         timer->setRepeatRate(rate);
+        timer->setWheel(getWheel());
 
-        timers_.emplace(id, timer);
-
-        timer->start();
-        return { id, timer };
+        return this->startTimer(id, timer);
     }
 
     void TimerManager::cancelTimer(const RepeatedTimerHandle &handle) {
@@ -68,12 +74,92 @@ namespace uranus::actor {
     }
 
     void TimerManager::cancelAll() {
+        // 已经从时间轮中取出, 正在触发的定时器发现纪元变化后自行退出
+        epoch_.fetch_add(1, std::memory_order_acq_rel);
+
+        // 其余的立即从时间轮中摘下, 不等到期才释放任务和捕获的对象
+        while (wheelTimers_ != nullptr) {
+            const auto timer = wheelTimers_->managed_;
+            this->unlink(timer.get());
+
+            timer->cancelled_.test_and_set(std::memory_order_acq_rel);
+            timer->completed_.test_and_set(std::memory_order_acq_rel);
+
+            if (timer->wheel_ != nullptr) {
+                timer->wheel_->cancel(timer.get());
+            }
+        }
+
         for (const auto &val: timers_ | std::views::values) {
             val->cancel();
         }
         timers_.clear();
     }
 
+    uint64_t TimerManager::epoch() const {
+        return epoch_.load(std::memory_order_acquire);
+    }
+
+    RepeatedTimerHandle TimerManager::startTimer(const int64_t id, const shared_ptr<RepeatedTimer> &timer) {
+        timer->start();
+
+        // 没能进入时间轮的定时器登记到表中, 其余串入链表, 以便cancelAll()时取消
+        if (timer->wheel_ == nullptr) {
+            timers_.emplace(id, timer);
+        } else {
+            this->link(timer);
+        }
+
+        return { id, timer };
+    }
+
+    TimingWheel *TimerManager::getWheel() {
+        // 所属的世界在Actor运行后才确定 第一次创建定时器时再查询
+        if (!resolved_) {
+            resolved_ = true;
+            if (const auto *service = ctx_.getTimerService()) {
+                wheel_ = service->getWheel(&ctx_);
+            }
+        }
+
+        return wheel_;
+    }
+
+    void TimerManager::link(const shared_ptr<RepeatedTimer> &timer) {
+        if (timer->managed_ != nullptr)
+            return;
+
+        timer->managed_ = timer;
+        timer->prevManaged_ = nullptr;
+        timer->nextManaged_ = wheelTimers_;
+
+        if (wheelTimers_ != nullptr) {
+            wheelTimers_->prevManaged_ = timer.get();
+        }
+        wheelTimers_ = timer.get();
+    }
+
+    void TimerManager::unlink(RepeatedTimer *timer) {
+        if (timer->managed_ == nullptr)
+            return;
+
+        if (timer->prevManaged_ != nullptr) {
+            timer->prevManaged_->nextManaged_ = timer->nextManaged_;
+        } else {
+            wheelTimers_ = timer->nextManaged_;
+        }
+
+        if (timer->nextManaged_ != nullptr) {
+            timer->nextManaged_->prevManaged_ = timer->prevManaged_;
+        }
+
+        timer->prevManaged_ = nullptr;
+        timer->nextManaged_ = nullptr;
+
+        // 可能释放最后一个引用, 放在最后
+        const auto self = std::move(timer->managed_);
+    }
+
     void TimerManager::removeOnCompleted(const int64_t id) {
         if (!ctx_.isRunning())
             return;
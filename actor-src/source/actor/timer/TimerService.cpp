@@ -0,0 +1,30 @@
+#include "timer/TimerService.h"
+
+#include <base/utils.h>
+#include <algorithm>
+
+
+namespace uranus::actor {
+
+    TimerService::TimerService(const asio::any_io_executor &exec, const size_t shards, const SteadyDuration resolution) {
+        for (size_t idx = 0; idx < std::max<size_t>(shards, 1); ++idx) {
+            auto wheel = std::make_shared<TimingWheel>(exec, resolution);
+            wheel->start();
+            wheels_.emplace_back(std::move(wheel));
+        }
+    }
+
+    TimerService::~TimerService() {
+        stop();
+    }
+
+    TimingWheel *TimerService::getWheel(const BaseActorContext *ctx) const {
+        return wheels_[utils::PointerShard(ctx, wheels_.size())].get();
+    }
+
+    void TimerService::stop() {
+        for (const auto &wheel : wheels_) {
+            wheel->stop();
+        }
+    }
+}
@@ -0,0 +1,193 @@
+#include "timer/TimingWheel.h"
+#include "timer/RepeatedTimer.h"
+#include "BaseActorContext.h"
+
+#include <asio/co_spawn.hpp>
+#include <asio/detached.hpp>
+#include <asio/post.hpp>
+#include <asio/dispatch.hpp>
+#include <algorithm>
+
+
+namespace uranus::actor {
+
+    using asio::co_spawn;
+    using asio::detached;
+
+    TimingWheel::TimingWheel(const asio::any_io_executor &exec, const SteadyDuration resolution)
+        : timer_(asio::make_strand(exec)),
+          resolution_(resolution > SteadyDuration::zero() ? resolution : std::chrono::milliseconds(10)),
+          origin_(std::chrono::steady_clock::now()),
+          idle_(false),
+          stopped_(false) {
+    }
+
+    TimingWheel::~TimingWheel() {
+        stop();
+    }
+
+    void TimingWheel::start() {
+        co_spawn(timer_.get_executor(), [self = shared_from_this()]() -> awaitable<void> {
+            co_await self->run();
+        }, detached);
+    }
+
+    void TimingWheel::stop() {
+        std::vector<shared_ptr<RepeatedTimer>> linked;
+
+        {
+            std::lock_guard lock(mutex_);
+            if (stopped_)
+                return;
+
+            stopped_ = true;
+
+            // 打断链表节点对自身的引用
+            std::vector<WheelNode *> nodes;
+            wheel_.clear(nodes);
+
+            for (auto *node : nodes) {
+                linked.emplace_back(std::move(static_cast<RepeatedTimer *>(node)->linked_));
+            }
+        }
+
+        asio::post(timer_.get_executor(), [self = weak_from_this(), this] {
+            if (self.lock()) {
+                timer_.cancel();
+            }
+        });
+    }
+
+    bool TimingWheel::schedule(const shared_ptr<RepeatedTimer> &timer, const SteadyTimePoint point, const SteadyDuration rate) {
+        if (timer == nullptr)
+            return false;
+
+        std::lock_guard lock(mutex_);
+        if (stopped_)
+            return false;
+
+        // 空闲时时间轮没有在走 先对齐到当前时刻
+        wheel_.align(toTick(std::chrono::steady_clock::now(), false));
+
+        timer->expire_ = toTick(point, true);
+        timer->interval_ = rate > SteadyDuration::zero() ? std::max<int64_t>(toTick(origin_ + rate, true), 1) : 0;
+        timer->linked_ = timer;
+
+        wheel_.insert(timer.get());
+
+        if (idle_) {
+            idle_ = false;
+            asio::post(timer_.get_executor(), [self = shared_from_this()] {
+                self->timer_.cancel();
+            });
+        }
+
+        return true;
+    }
+
+    void TimingWheel::cancel(RepeatedTimer *timer) {
+        shared_ptr<RepeatedTimer> linked;
+
+        {
+            std::lock_guard lock(mutex_);
+            if (timer == nullptr || !HierarchicalWheel::linked(timer))
+                return;
+
+            wheel_.remove(timer);
+            linked = std::move(timer->linked_);
+        }
+    }
+
+    awaitable<void> TimingWheel::run() {
+        std::vector<WheelNode *> nodes;
+        std::vector<shared_ptr<RepeatedTimer>> expired;
+
+        while (true) {
+            SteadyTimePoint next;
+
+            {
+                std::lock_guard lock(mutex_);
+                if (stopped_)
+                    break;
+
+                if (wheel_.size() == 0) {
+                    idle_ = true;
+                    next = SteadyTimePoint::max();
+                } else {
+                    next = origin_ + resolution_ * (wheel_.current() + 1);
+                }
+            }
+
+            timer_.expires_at(next);
+
+            // 被schedule()唤醒时会返回operation_aborted
+            if (const auto [ec] = co_await timer_.async_wait(); ec && ec != asio::error::operation_aborted)
+                break;
+
+            {
+                std::lock_guard lock(mutex_);
+                if (stopped_)
+                    break;
+
+                wheel_.advance(toTick(std::chrono::steady_clock::now(), false), nodes);
+
+                for (auto *node : nodes) {
+                    expired.emplace_back(std::move(static_cast<RepeatedTimer *>(node)->linked_));
+                }
+                nodes.clear();
+            }
+
+            for (const auto &timer : expired) {
+                this->fire(timer);
+            }
+
+            expired.clear();
+        }
+    }
+
+    void TimingWheel::fire(const shared_ptr<RepeatedTimer> &timer) {
+        const auto owner = timer->owner_.lock();
+
+        if (owner == nullptr || timer->expired()) {
+            timer->completed_.test_and_set(std::memory_order_release);
+            return;
+        }
+
+        // 信封到达之前被取消的定时器不再执行
+        auto evl = Envelope::makeCallback([timer](BaseActor *actor) {
+            if (!timer->expired() && timer->task_) {
+                timer->task_(actor);
+            }
+
+            // 单次定时器到此结束
+            if (timer->rate_ <= SteadyDuration::zero()) {
+                timer->release();
+            }
+        });
+        owner->pushEnvelope(std::move(evl));
+
+        if (timer->interval_ > 0) {
+            std::lock_guard lock(mutex_);
+            if (!stopped_ && !timer->expired()) {
+                timer->expire_ += timer->interval_;
+                timer->linked_ = timer;
+
+                wheel_.insert(timer.get());
+                return;
+            }
+        }
+
+        // 单次定时器触发后 或重复定时器被取消后, 不再持有它
+        timer->completed_.test_and_set(std::memory_order_release);
+    }
+
+    int64_t TimingWheel::toTick(const SteadyTimePoint point, const bool ceil) const {
+        if (point <= origin_)
+            return 0;
+
+        const auto elapsed = (point - origin_).count();
+        const auto step = resolution_.count();
+
+        return ceil ? (elapsed + step - 1) / step : elapsed / step;
+    }
+}
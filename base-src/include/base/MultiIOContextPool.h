@@ -26,7 +26,8 @@ namespace uranus {
 
         DISABLE_COPY_MOVE(MultiIOContextPool)
 
-        void start(size_t capacity = 4);
+        /// cores非空时第i个线程绑定到cores[i % cores.size()]
+        void start(size_t capacity = 4, const std::vector<int> &cores = {});
         void stop();
 
         asio::io_context& getIOContext();
@@ -5,17 +5,14 @@
 #include <cmath>
 #include <stack>
 #include <vector>
-#include <unordered_map>
-#include <shared_mutex>
+#include <atomic>
+#include <mutex>
 
 
 namespace uranus {
 
     using std::vector;
     using std::stack;
-    using std::unordered_map;
-    using std::shared_mutex;
-    using std::shared_lock;
     using std::unique_lock;
     using moodycamel::ConcurrentQueue;
     using ThreadID = std::thread::id;
@@ -34,6 +31,12 @@ namespace uranus {
 
         friend class Handle;
 
+        /// 每个线程一份, 其他线程回收的对象经由queue还给创建它的线程
+        struct LocalQueue {
+            ConcurrentQueue<kClearType<T> *> queue;
+            std::atomic_bool alive{true};
+        };
+
     public:
         using Type = kClearType<T>;
 
@@ -51,19 +54,21 @@ namespace uranus {
         class Handle {
 
             Recycler *owner_;
-            ThreadID tid_;
+
+            /// 创建时缓存所属线程的归还队列, 跨线程回收不再查表
+            LocalQueue *local_;
 
         public:
             Handle() = delete;
 
             explicit Handle(Recycler *ptr)
-                : owner_(ptr) {
-                tid_ = kThreadId;
+                : owner_(ptr),
+                  local_(kLocalDestroyed ? nullptr : kLocal.local) {
             }
 
             void recycle(Type *ptr) {
                 if (owner_) {
-                    owner_->recycle(tid_, ptr);
+                    owner_->recycle(local_, ptr);
                     return;
                 }
                 delete ptr;
@@ -71,38 +76,15 @@ namespace uranus {
         };
 
         virtual ~Recycler() {
-            while (!kStack.empty()) {
-                delete kStack.top();
-                kStack.pop();
-            }
-
-            typename decltype(weakQueue_)::mapped_type weak = nullptr;
+            // 各线程的空闲栈由线程本地的LocalPool在线程退出时释放
+            // 这里只清理线程退出后才归还到队列中的对象
+            unique_lock lock(mutex_);
 
-            {
-                unique_lock lock(mutex_);
-                const auto it = weakQueue_.find(kThreadId);
-                if (it != weakQueue_.end()) {
-                    weak = it->second;
-                }
-                weakQueue_.erase(it);
+            for (const auto &local : locals_) {
+                DrainQueue(local->queue);
             }
 
-            if (weak != nullptr) {
-                vector<Type *> bulk(16);
-
-                while (true) {
-                    size_t num = weak->try_dequeue_bulk(bulk.data(), 16);
-
-                    if (num == 0)
-                        break;
-
-                    while (num-- > 0) {
-                        delete bulk[num];
-                    }
-                }
-
-                delete weak;
-            }
+            locals_.clear();
         }
 
         Recycler(const Recycler &) = delete;
@@ -144,48 +126,53 @@ namespace uranus {
         }
 
         Type *acquire() {
-            if (kUsage < 0) {
+            // 线程退出过程中不再缓存, 直接创建, 回收时直接释放
+            if (kLocalDestroyed) {
+                return this->create(Handle(this));
+            }
+
+            auto &pool = kLocal;
+
+            if (pool.usage < 0) {
                 throw std::runtime_error("Recycler is not yet initial");
             }
 
             // If local stack not empty
-            if (!kStack.empty()) {
-                auto *elem = kStack.top();
-                kStack.pop();
+            if (!pool.idle.empty()) {
+                auto *elem = pool.idle.top();
+                pool.idle.pop();
 
-                ++kUsage;
+                ++pool.usage;
                 return elem;
             }
 
             // Steal from the weak queue
-            if (auto *weak = getWeakQueue(kThreadId)) {
-                if (weak->size_approx()) {
-                    vector<Type *> bulk(16);
+            if (pool.local->queue.size_approx()) {
+                Type *bulk[16];
 
-                    while (true) {
-                        size_t num = weak->try_dequeue_bulk(bulk.data(), 16);
+                while (true) {
+                    size_t num = pool.local->queue.try_dequeue_bulk(bulk, 16);
 
-                        if (num == 0)
-                            break;
+                    if (num == 0)
+                        break;
 
-                        while (num-- > 0)
-                            kStack.push(bulk[num]);
-                    }
+                    while (num-- > 0)
+                        pool.idle.push(bulk[num]);
+                }
 
-                    // Try pop from local stack again
-                    if (!kStack.empty()) {
-                        auto *elem = kStack.top();
-                        kStack.pop();
+                // Try pop from local stack again
+                if (!pool.idle.empty()) {
+                    auto *elem = pool.idle.top();
+                    pool.idle.pop();
 
-                        ++kUsage;
-                        return elem;
-                    }
+                    ++pool.usage;
+                    return elem;
                 }
             }
 
             // Create a new one
             auto *elem = this->create(Handle(this));
-            ++kUsage;
+            ++pool.usage;
 
             return elem;
         }
@@ -199,13 +186,18 @@ namespace uranus {
         }
 
         void shrink() {
-            const size_t idle = kStack.size();
-            const size_t total = kUsage + idle;
+            if (kLocalDestroyed)
+                return;
+
+            auto &pool = kLocal;
+
+            const size_t idle = pool.idle.size();
+            const size_t total = pool.usage + idle;
 
             if (idle < halfCollect_)
                 return;
 
-            if (const double usageRate = (static_cast<double>(kUsage) / static_cast<double>(total));
+            if (const double usageRate = (static_cast<double>(pool.usage) / static_cast<double>(total));
                 idle < fullCollect_ && usageRate > collectThreshold_)
                 return;
 
@@ -219,9 +211,9 @@ namespace uranus {
             if (num <= 0)
                 return;
 
-            while (num-- > 0 && !kStack.empty()) {
-                delete kStack.top();
-                kStack.pop();
+            while (num-- > 0 && !pool.idle.empty()) {
+                delete pool.idle.top();
+                pool.idle.pop();
             }
         }
 
@@ -236,61 +228,95 @@ namespace uranus {
         }
 
         [[nodiscard]] static bool initialized() noexcept {
-            return kThreadId != std::thread::id() && kUsage >= 0;
+            return kLocalDestroyed || kLocal.usage >= 0;
         }
 
         void initial(const size_t capacity = kRecyclerMinimumCapacity) {
-            if (kThreadId == std::thread::id()) {
-                kThreadId = std::this_thread::get_id();
-            }
-
             // Recycle has already initial
-            if (kUsage >= 0) {
+            if (initialized()) {
                 return;
             }
 
+            auto &pool = kLocal;
+
+            {
+                auto local = std::make_unique<LocalQueue>();
+                pool.local = local.get();
+
+                unique_lock lock(mutex_);
+                locals_.emplace_back(std::move(local));
+            }
+
             for (auto idx = capacity; idx > 0; --idx) {
                 auto *elem = this->create(Handle(this));
-                kStack.push(elem);
+                pool.idle.push(elem);
             }
 
-            kUsage = 0;
-
-            unique_lock lock(mutex_);
-            weakQueue_[kThreadId] = new ConcurrentQueue<Type *>();
+            pool.usage = 0;
         }
 
         virtual Type *create(const Handle &) const = 0;
 
     private:
-        void recycle(const ThreadID tid, Type *ptr) {
+        /// 线程本地的空闲对象, 线程退出时全部释放
+        struct LocalPool {
+            stack<Type *, vector<Type *>> idle;
+            LocalQueue *local = nullptr;
+            int64_t usage = -1;
+
+            ~LocalPool() {
+                // 先标记, 释放过程中再回收到本线程的对象直接删除
+                kLocalDestroyed = true;
+
+                while (!idle.empty()) {
+                    delete idle.top();
+                    idle.pop();
+                }
+
+                if (local != nullptr) {
+                    local->alive.store(false, std::memory_order_release);
+                    DrainQueue(local->queue);
+                }
+            }
+        };
+
+        static void DrainQueue(ConcurrentQueue<Type *> &queue) {
+            Type *bulk[16];
+
+            while (true) {
+                size_t num = queue.try_dequeue_bulk(bulk, 16);
+
+                if (num == 0)
+                    break;
+
+                while (num-- > 0) {
+                    delete bulk[num];
+                }
+            }
+        }
+
+        void recycle(LocalQueue *local, Type *ptr) {
             if (!ptr)
                 return;
 
-            if (tid == kThreadId) {
-                kStack.push(ptr);
-                --kUsage;
+            if (!kLocalDestroyed && local != nullptr && local == kLocal.local) {
+                kLocal.idle.push(ptr);
+                --kLocal.usage;
                 return;
             }
 
-            if (auto *weak = getWeakQueue(tid)) {
-                weak->enqueue(ptr);
+            // 所属线程已退出时直接释放; 与线程退出竞争而留在队列中的对象由析构函数释放
+            if (local != nullptr && local->alive.load(std::memory_order_acquire)) {
+                local->queue.enqueue(ptr);
                 return;
             }
 
             delete ptr;
         }
 
-        auto getWeakQueue(const ThreadID tid) const {
-            shared_lock lock(mutex_);
-            const auto it = weakQueue_.find(tid);
-            return it != weakQueue_.end() ? it->second : nullptr;
-        }
-
     private:
-        static thread_local stack<Type *, vector<Type *>> kStack;
-        static thread_local ThreadID kThreadId;
-        static thread_local int64_t kUsage;
+        static thread_local LocalPool kLocal;
+        static thread_local bool kLocalDestroyed;
 
         size_t halfCollect_;
         size_t fullCollect_;
@@ -298,19 +324,17 @@ namespace uranus {
         double collectThreshold_;
         double collectRate_;
 
-        mutable shared_mutex mutex_;
-        unordered_map<ThreadID, ConcurrentQueue<Type *> *> weakQueue_;
+        /// 只在线程初始化和析构时访问
+        std::mutex mutex_;
+        vector<std::unique_ptr<LocalQueue>> locals_;
     };
 
 
     template<class T>
-    thread_local stack<kClearType<T> *, vector<kClearType<T> *>> Recycler<T>::kStack;
-
-    template<class T>
-    thread_local ThreadID Recycler<T>::kThreadId;
+    thread_local typename Recycler<T>::LocalPool Recycler<T>::kLocal;
 
     template<class T>
-    thread_local int64_t Recycler<T>::kUsage = -1;
+    thread_local bool Recycler<T>::kLocalDestroyed = false;
 }
 
 
@@ -17,7 +17,8 @@ namespace uranus {
 
         DISABLE_COPY_MOVE(SingleIOContextPool)
 
-        void start(size_t capacity = 4);
+        /// cores非空时第i个线程绑定到cores[i % cores.size()]
+        void start(size_t capacity = 4, const std::vector<int> &cores = {});
         void stop();
 
         [[nodiscard]] asio::io_context& getIOContext();
@@ -0,0 +1,285 @@
+#pragma once
+
+#include <unordered_map>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <array>
+#include <mutex>
+
+
+/**
+ * 读多写少的并发表
+ * 按键分片, 每个分片再按键分成kLeafCount个叶子表, 快照是叶子表指针的目录;
+ * 写入时只复制目录和键所在的叶子表, 其余叶子表与旧快照共享, 然后发布新快照, 分片版本号加一;
+ * 每个读线程在thread_local中按实例缓存各分片的快照, 版本号未变化时直接查询本地快照,
+ * 不加锁, 不写任何共享的缓存行; 版本号变化时从原子的快照指针刷新, 不等待写线程的锁.
+ * 读取返回借用的指针, 在该线程下一次查询同一实例的同一分片之前有效
+ */
+template<class Key, class Value, size_t kShardCount = 16, size_t kLeafCount = 64>
+class SnapshotMap final {
+
+    using Map       = std::unordered_map<Key, Value>;
+    using Leaf      = std::shared_ptr<const Map>;
+
+    struct Directory {
+        std::array<Leaf, kLeafCount> leaves;
+        size_t size = 0;
+    };
+
+    using Snapshot  = std::shared_ptr<const Directory>;
+
+    struct alignas(64) Shard {
+        /// 只在写入时修改, 读线程只读取
+        std::atomic<uint64_t> version;
+
+        /// 串行化写入, 读线程不使用
+        mutable std::mutex mutex;
+
+        /// 先发布快照再增加版本号, 读线程看到新版本号时必然能取到对应的快照
+        std::atomic<Snapshot> snapshot;
+    };
+
+    struct LocalCache {
+        /// 所属实例的serial_, purge()后置0, 槽位可被其他实例复用;
+        /// 其他实例析构时可能与本线程的查找同时访问, 因此是原子的
+        std::atomic<uint64_t> owner = 0;
+        std::array<uint64_t, kShardCount> versions{};
+        std::array<Snapshot, kShardCount> snapshots{};
+    };
+
+public:
+    SnapshotMap();
+    ~SnapshotMap();
+
+    SnapshotMap(const SnapshotMap &) = delete;
+    SnapshotMap &operator=(const SnapshotMap &) = delete;
+
+    SnapshotMap(SnapshotMap &&) = delete;
+    SnapshotMap &operator=(SnapshotMap &&) = delete;
+
+    /// 借用的指针, 由当前线程的本地快照持有, 在当前线程对本实例同一分片的下一次查询或purge()之前有效;
+    /// 同一线程交替查询同类型的多个实例互不影响
+    [[nodiscard]] const Value *find(const Key &key) const;
+
+    /// 返回旧值, 不存在时返回默认值.
+    /// 被替换或删除的值仍由各线程的本地快照共享, 直到该线程在同一分片上再次查询或purge()
+    Value insert_or_assign(const Key &key, Value value);
+    Value erase(const Key &key);
+
+    void clear();
+
+    [[nodiscard]] size_t size() const;
+
+    /// 遍历各分片当前的快照
+    void forEach(const std::function<void(const Key &, const Value &)> &func) const;
+
+    /// 丢弃所有线程缓存的快照, 只能在没有读线程运行时调用, 如停服时
+    void purge();
+
+private:
+    [[nodiscard]] static size_t shardOf(const Key &key);
+    [[nodiscard]] static size_t leafOf(const Key &key);
+
+    [[nodiscard]] static Snapshot emptySnapshot();
+
+    [[nodiscard]] LocalCache &local() const;
+
+    template<class Functor>
+    Value modify(const Key &key, Functor &&func);
+
+private:
+    std::array<Shard, kShardCount> shards_;
+
+    /// 区分不同的实例, 作为线程本地缓存的键, 避免地址复用后误用旧的本地缓存
+    uint64_t serial_;
+
+    mutable std::mutex cacheMutex_;
+    mutable std::vector<std::weak_ptr<LocalCache>> caches_;
+};
+
+inline std::atomic<uint64_t> &SnapshotMapSerial() {
+    static std::atomic<uint64_t> serial{0};
+    return serial;
+}
+
+template<class Key, class Value, size_t kShardCount, size_t kLeafCount>
+SnapshotMap<Key, Value, kShardCount, kLeafCount>::SnapshotMap()
+    : serial_(SnapshotMapSerial().fetch_add(1, std::memory_order_relaxed) + 1) {
+    for (auto &shard : shards_) {
+        // 本地缓存的版本号从0开始, 第一次查询时必然刷新
+        shard.version.store(1, std::memory_order_relaxed);
+        shard.snapshot.store(emptySnapshot(), std::memory_order_relaxed);
+    }
+}
+
+template<class Key, class Value, size_t kShardCount, size_t kLeafCount>
+SnapshotMap<Key, Value, kShardCount, kLeafCount>::~SnapshotMap() {
+    purge();
+}
+
+template<class Key, class Value, size_t kShardCount, size_t kLeafCount>
+const Value *SnapshotMap<Key, Value, kShardCount, kLeafCount>::find(const Key &key) const {
+    const auto idx = shardOf(key);
+    auto &cache = local();
+    const auto &shard = shards_[idx];
+
+    // 记录读取快照之前的版本号, 与写入交错时最多多刷新一次, 不会把旧快照当成新版本
+    if (const auto version = shard.version.load(std::memory_order_acquire); cache.versions[idx] != version) {
+        cache.snapshots[idx] = shard.snapshot.load(std::memory_order_acquire);
+        cache.versions[idx] = version;
+    }
+
+    const auto &map = *cache.snapshots[idx]->leaves[leafOf(key)];
+    const auto iter = map.find(key);
+    return iter == map.end() ? nullptr : &iter->second;
+}
+
+template<class Key, class Value, size_t kShardCount, size_t kLeafCount>
+Value SnapshotMap<Key, Value, kShardCount, kLeafCount>::insert_or_assign(const Key &key, Value value) {
+    return modify(key, [&key, &value](Map &map) {
+        Value old{};
+        if (const auto iter = map.find(key); iter != map.end()) {
+            old = std::move(iter->second);
+        }
+        map.insert_or_assign(key, std::move(value));
+        return old;
+    });
+}
+
+template<class Key, class Value, size_t kShardCount, size_t kLeafCount>
+Value SnapshotMap<Key, Value, kShardCount, kLeafCount>::erase(const Key &key) {
+    return modify(key, [&key](Map &map) {
+        Value old{};
+        if (const auto iter = map.find(key); iter != map.end()) {
+            old = std::move(iter->second);
+            map.erase(iter);
+        }
+        return old;
+    });
+}
+
+template<class Key, class Value, size_t kShardCount, size_t kLeafCount>
+void SnapshotMap<Key, Value, kShardCount, kLeafCount>::clear() {
+    for (auto &shard : shards_) {
+        std::lock_guard lock(shard.mutex);
+        shard.snapshot.store(emptySnapshot(), std::memory_order_release);
+        shard.version.fetch_add(1, std::memory_order_release);
+    }
+}
+
+template<class Key, class Value, size_t kShardCount, size_t kLeafCount>
+size_t SnapshotMap<Key, Value, kShardCount, kLeafCount>::size() const {
+    size_t result = 0;
+    for (const auto &shard : shards_) {
+        result += shard.snapshot.load(std::memory_order_acquire)->size;
+    }
+    return result;
+}
+
+template<class Key, class Value, size_t kShardCount, size_t kLeafCount>
+void SnapshotMap<Key, Value, kShardCount, kLeafCount>::forEach(const std::function<void(const Key &, const Value &)> &func) const {
+    for (const auto &shard : shards_) {
+        const auto snapshot = shard.snapshot.load(std::memory_order_acquire);
+
+        for (const auto &leaf : snapshot->leaves) {
+            for (const auto &[key, val] : *leaf) {
+                std::invoke(func, key, val);
+            }
+        }
+    }
+}
+
+template<class Key, class Value, size_t kShardCount, size_t kLeafCount>
+void SnapshotMap<Key, Value, kShardCount, kLeafCount>::purge() {
+    std::lock_guard lock(cacheMutex_);
+
+    for (const auto &weak : caches_) {
+        if (const auto cache = weak.lock()) {
+            cache->owner.store(0, std::memory_order_relaxed);
+            cache->versions.fill(0);
+            for (auto &snapshot : cache->snapshots) {
+                snapshot.reset();
+            }
+        }
+    }
+
+    caches_.clear();
+}
+
+template<class Key, class Value, size_t kShardCount, size_t kLeafCount>
+size_t SnapshotMap<Key, Value, kShardCount, kLeafCount>::shardOf(const Key &key) {
+    return std::hash<Key>{}(key) % kShardCount;
+}
+
+template<class Key, class Value, size_t kShardCount, size_t kLeafCount>
+size_t SnapshotMap<Key, Value, kShardCount, kLeafCount>::leafOf(const Key &key) {
+    // 分片已经用掉了低位的取模结果, 叶子表使用剩余的部分
+    return std::hash<Key>{}(key) / kShardCount % kLeafCount;
+}
+
+template<class Key, class Value, size_t kShardCount, size_t kLeafCount>
+typename SnapshotMap<Key, Value, kShardCount, kLeafCount>::Snapshot SnapshotMap<Key, Value, kShardCount, kLeafCount>::emptySnapshot() {
+    auto dir = std::make_shared<Directory>();
+    const auto empty = std::make_shared<const Map>();
+    dir->leaves.fill(empty);
+    return dir;
+}
+
+template<class Key, class Value, size_t kShardCount, size_t kLeafCount>
+typename SnapshotMap<Key, Value, kShardCount, kLeafCount>::LocalCache &SnapshotMap<Key, Value, kShardCount, kLeafCount>::local() const {
+    // 同一模板实例化的所有实例共用, 按serial_区分; 实例数量很少, 线性查找即可
+    thread_local std::vector<std::shared_ptr<LocalCache>> caches;
+
+    std::shared_ptr<LocalCache> *vacant = nullptr;
+    for (auto &cache : caches) {
+        if (cache->owner.load(std::memory_order_relaxed) == serial_)
+            return *cache;
+
+        // 所属实例已经purge()或析构
+        if (cache->owner.load(std::memory_order_relaxed) == 0 && vacant == nullptr) {
+            vacant = &cache;
+        }
+    }
+
+    auto cache = std::make_shared<LocalCache>();
+    cache->owner.store(serial_, std::memory_order_relaxed);
+
+    {
+        std::lock_guard lock(cacheMutex_);
+        std::erase_if(caches_, [](const auto &weak) {
+            return weak.expired();
+        });
+        caches_.emplace_back(cache);
+    }
+
+    if (vacant != nullptr) {
+        *vacant = std::move(cache);
+        return **vacant;
+    }
+
+    return *caches.emplace_back(std::move(cache));
+}
+
+template<class Key, class Value, size_t kShardCount, size_t kLeafCount>
+template<class Functor>
+Value SnapshotMap<Key, Value, kShardCount, kLeafCount>::modify(const Key &key, Functor &&func) {
+    auto &shard = shards_[shardOf(key)];
+    std::lock_guard lock(shard.mutex);
+
+    // 只复制目录(kLeafCount个指针)和键所在的叶子表, 代价与表的总大小无关
+    auto next = std::make_shared<Directory>(*shard.snapshot.load(std::memory_order_relaxed));
+    auto &leaf = next->leaves[leafOf(key)];
+
+    auto map = std::make_shared<Map>(*leaf);
+    auto old = std::invoke(std::forward<Functor>(func), *map);
+
+    next->size = next->size - leaf->size() + map->size();
+    leaf = std::move(map);
+
+    shard.snapshot.store(std::move(next), std::memory_order_release);
+    shard.version.fetch_add(1, std::memory_order_release);
+
+    return old;
+}
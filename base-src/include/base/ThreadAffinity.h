@@ -0,0 +1,12 @@
+#pragma once
+
+#include "base.export.h"
+
+#include <thread>
+
+
+namespace uranus {
+
+    /// 将线程绑定到指定的CPU核心, 平台不支持或设置失败时返回false
+    BASE_API bool SetThreadAffinity(std::thread &th, int core);
+}
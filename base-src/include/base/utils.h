@@ -4,6 +4,8 @@
 #include <string>
 #include <string_view>
 #include <bit>
+#include <cstdint>
+#include <limits>
 
 namespace uranus::utils {
     namespace crypto {
@@ -296,6 +298,23 @@ namespace uranus::utils {
         }
     }
 
+    /**
+     * 按指针选择分片
+     * std::hash对指针是恒等映射, 而对象按64字节对齐, 直接取模在分片数为2的幂时全部落在0号分片,
+     * 这里先去掉对齐的低位再用MurmurHash3的fmix64混合
+     */
+    inline size_t PointerShard(const void *ptr, const size_t count) {
+        auto x = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)) >> 6;
+
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDULL;
+        x ^= x >> 33;
+        x *= 0xC4CEB9FE1A85EC53ULL;
+        x ^= x >> 33;
+
+        return static_cast<size_t>(x % count);
+    }
+
     constexpr unsigned int StringToTag_Internal(const char *s, const size_t l, const unsigned int h) {
         // Unsets the 6 high bits of h, therefore no overflow happens
         return (l == 0) ? h : StringToTag_Internal(s + 1, l - 1,(((std::numeric_limits<unsigned int>::max)() >> 6) & h * 33) ^ static_cast<unsigned char>(*s));
@@ -12,6 +12,12 @@ namespace uranus::network {
     template<kCodecType Codec>
     class ConnectionAdapter : public BaseConnection {
 
+        /// 写队列中的一项, 普通消息或已编码的共享帧
+        struct OutputItem {
+            typename Codec::MessageHandleType msg;
+            WireBuffer wire;
+        };
+
     public:
         using CodecType = Codec;
         using MessageType = Codec::MessageType;
@@ -31,6 +37,17 @@ namespace uranus::network {
         void send(MessageHandleType &&msg);
         void send(MessageType *msg);
 
+        /// 发送已编码的帧, 不经过beforeWrite()/afterWrite()
+        void sendWire(const WireBuffer &buffer);
+
+        /// 接收方处理不过来时暂停从socket读取, 由TCP流量控制限制对端发送
+        void pauseRead();
+        void resumeRead();
+
+        /// 合并写入: 写循环被唤醒后取出队列中已有的消息, 用一次写入发送, 每次最多messages条或bytes字节;
+        /// messages不大于1时关闭, 须在connect()之前设置
+        void setWriteCoalescing(size_t messages, size_t bytes);
+
     protected:
         awaitable<void> readLoop() override;
         awaitable<void> writeLoop() override;
@@ -39,16 +56,36 @@ namespace uranus::network {
         virtual void beforeWrite(MessageType *msg) = 0;
         virtual void afterWrite(MessageHandleType &&msg) = 0;
 
+    private:
+        awaitable<void> writeOne(OutputItem &&item);
+        awaitable<void> writeBatch(OutputItem &&first);
+
     private:
         Codec codec_;
-        ConcurrentChannel<MessageHandleType> output_;
+        ConcurrentChannel<OutputItem> output_;
+
+        size_t coalesceMessages_;
+        size_t coalesceBytes_;
+
+        // 只在写循环中访问, 复用容量
+        WriteBatch batch_;
+        std::vector<MessageHandleType> pending_;
+        std::vector<WireBuffer> wires_;
+
+        // 只在socket执行器上访问
+        SteadyTimer readGate_;
+        bool readPaused_;
     };
 
     template<kCodecType Codec>
     ConnectionAdapter<Codec>::ConnectionAdapter(TcpSocket &&socket)
         : BaseConnection(std::move(socket)),
           codec_(dynamic_cast<BaseConnection &>(*this)),
-          output_(socket_.get_executor(), 1024) {
+          output_(socket_.get_executor(), 1024),
+          coalesceMessages_(0),
+          coalesceBytes_(0),
+          readGate_(socket_.get_executor()),
+          readPaused_(false) {
     }
 
     template<kCodecType Codec>
@@ -72,6 +109,7 @@ namespace uranus::network {
 #endif
 
         watchdog_.cancel();
+        readGate_.cancel();
 
         output_.cancel();
         output_.close();
@@ -120,7 +158,7 @@ namespace uranus::network {
             return;
 
         if (isConnected() && output_.is_open()) {
-            output_.try_send_via_dispatch(error_code{}, std::move(msg));
+            output_.try_send_via_dispatch(error_code{}, OutputItem{ std::move(msg), nullptr });
         }
     }
 
@@ -133,6 +171,40 @@ namespace uranus::network {
         this->send(std::move(handle));
     }
 
+    template<kCodecType Codec>
+    void ConnectionAdapter<Codec>::sendWire(const WireBuffer &buffer) {
+        if (buffer == nullptr)
+            return;
+
+        if (isConnected() && output_.is_open()) {
+            output_.try_send_via_dispatch(error_code{}, OutputItem{ nullptr, buffer });
+        }
+    }
+
+    template<kCodecType Codec>
+    void ConnectionAdapter<Codec>::pauseRead() {
+        asio::dispatch(socket_.get_executor(), [self = shared_from_this(), this] {
+            readPaused_ = true;
+        });
+    }
+
+    template<kCodecType Codec>
+    void ConnectionAdapter<Codec>::resumeRead() {
+        asio::dispatch(socket_.get_executor(), [self = shared_from_this(), this] {
+            if (!readPaused_)
+                return;
+
+            readPaused_ = false;
+            readGate_.cancel();
+        });
+    }
+
+    template<kCodecType Codec>
+    void ConnectionAdapter<Codec>::setWriteCoalescing(const size_t messages, const size_t bytes) {
+        coalesceMessages_ = messages;
+        coalesceBytes_ = bytes;
+    }
+
     template<kCodecType Codec>
     awaitable<void> ConnectionAdapter<Codec>::readLoop() {
         try {
@@ -146,6 +218,12 @@ namespace uranus::network {
                 }
 
                 this->onReadMessage(std::move(msg));
+
+                // 等待resumeRead()或断开连接
+                while (readPaused_ && isConnected()) {
+                    readGate_.expires_at(SteadyTimePoint::max());
+                    co_await readGate_.async_wait();
+                }
             }
         } catch (std::exception &e) {
             onException(e);
@@ -157,7 +235,7 @@ namespace uranus::network {
     awaitable<void> ConnectionAdapter<Codec>::writeLoop() {
         try {
             while (isConnected() && output_.is_open()) {
-                auto [ec, msg] = co_await output_.async_receive();
+                auto [ec, item] = co_await output_.async_receive();
 
                 if (ec == asio::error::operation_aborted ||
                     ec == asio::experimental::error::channel_cancelled ||
@@ -171,21 +249,113 @@ namespace uranus::network {
                     break;
                 }
 
-                if (msg == nullptr)
-                    continue;
-
-                this->beforeWrite(msg.get());
-
-                if (const auto writeEc = co_await codec_.encode(msg.get())) {
-                    onErrorCode(writeEc);
-                    disconnect();
+                if (coalesceMessages_ > 1) {
+                    co_await this->writeBatch(std::move(item));
+                } else {
+                    co_await this->writeOne(std::move(item));
                 }
-
-                this->afterWrite(std::move(msg));
             }
         } catch (std::exception &e) {
             onException(e);
             disconnect();
         }
     }
+
+    template<kCodecType Codec>
+    awaitable<void> ConnectionAdapter<Codec>::writeOne(OutputItem &&item) {
+        if (item.wire != nullptr) {
+            if (const auto writeEc = co_await codec_.write(item.wire)) {
+                onErrorCode(writeEc);
+                disconnect();
+            }
+            co_return;
+        }
+
+        auto msg = std::move(item.msg);
+        if (msg == nullptr)
+            co_return;
+
+        this->beforeWrite(msg.get());
+
+        if (const auto writeEc = co_await codec_.encode(msg.get())) {
+            onErrorCode(writeEc);
+            disconnect();
+        }
+
+        this->afterWrite(std::move(msg));
+    }
+
+    template<kCodecType Codec>
+    awaitable<void> ConnectionAdapter<Codec>::writeBatch(OutputItem &&first) {
+        batch_.clear();
+        pending_.clear();
+        wires_.clear();
+
+        // 编解码器不支持合并时单独写入的消息
+        MessageHandleType single;
+
+        auto lAppend = [this, &single](OutputItem &&item) {
+            if (item.wire != nullptr) {
+                batch_.reference(item.wire->data(), item.wire->size());
+                wires_.emplace_back(std::move(item.wire));
+                return;
+            }
+
+            if (item.msg == nullptr)
+                return;
+
+            this->beforeWrite(item.msg.get());
+
+            if (codec_.gather(item.msg.get(), batch_)) {
+                pending_.emplace_back(std::move(item.msg));
+            } else {
+                single = std::move(item.msg);
+            }
+        };
+
+        lAppend(std::move(first));
+
+        // 取出队列中已有的消息, 不再等待
+        size_t count = 1;
+        while (single == nullptr && count < coalesceMessages_ && batch_.bytes() < coalesceBytes_) {
+            OutputItem next;
+            bool received = false;
+
+            output_.try_receive([&next, &received](const error_code ec, OutputItem item) {
+                if (!ec) {
+                    next = std::move(item);
+                    received = true;
+                }
+            });
+
+            if (!received)
+                break;
+
+            lAppend(std::move(next));
+            ++count;
+        }
+
+        if (!batch_.empty()) {
+            if (const auto writeEc = co_await codec_.flush(batch_)) {
+                onErrorCode(writeEc);
+                disconnect();
+            }
+        }
+
+        for (auto &msg : pending_) {
+            this->afterWrite(std::move(msg));
+        }
+
+        pending_.clear();
+        wires_.clear();
+
+        if (single != nullptr && isConnected()) {
+            if (const auto writeEc = co_await codec_.encode(single.get())) {
+                onErrorCode(writeEc);
+                disconnect();
+            }
+
+            this->afterWrite(std::move(single));
+        }
+    }
 }
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "BaseConnection.h"
+#include "WriteBatch.h"
+
+#include <asio/write.hpp>
+#include <cstdint>
+#include <vector>
 
 
 namespace uranus::network {
@@ -9,6 +14,9 @@ namespace uranus::network {
     using std::error_code;
     using std::derived_from;
 
+    /// 已经编码完成的只读帧, 广播时由多个连接共享
+    using WireBuffer = std::shared_ptr<const std::vector<uint8_t>>;
+
     template<class T>
     requires derived_from<T, Message>
     class MessageCodec {
@@ -31,6 +39,15 @@ namespace uranus::network {
         virtual awaitable<ResultTuple> decode() = 0;
         virtual awaitable<error_code> encode(MessageType *msg) = 0;
 
+        /// 直接写入已编码的帧
+        virtual awaitable<error_code> write(const WireBuffer &buffer);
+
+        /// 把消息编码进合并写入的批次, 消息在flush()完成前必须有效; 不支持时返回false, 改用encode()
+        virtual bool gather(MessageType *msg, WriteBatch &batch);
+
+        /// 一次写入整个批次
+        virtual awaitable<error_code> flush(WriteBatch &batch);
+
     private:
         BaseConnection &conn_;
     };
@@ -57,4 +74,35 @@ namespace uranus::network {
     TcpSocket &MessageCodec<T>::socket() const {
         return conn_.socket();
     }
+
+    template<class T>
+    requires derived_from<T, Message>
+    awaitable<error_code> MessageCodec<T>::write(const WireBuffer &buffer) {
+        if (buffer == nullptr || buffer->empty())
+            co_return error_code{};
+
+        const auto [ec, len] = co_await asio::async_write(socket(), asio::buffer(*buffer));
+        co_return ec;
+    }
+
+    template<class T>
+    requires derived_from<T, Message>
+    bool MessageCodec<T>::gather(MessageType *, WriteBatch &) {
+        return false;
+    }
+
+    template<class T>
+    requires derived_from<T, Message>
+    awaitable<error_code> MessageCodec<T>::flush(WriteBatch &batch) {
+        if (batch.empty())
+            co_return error_code{};
+
+#ifdef URANUS_SSL
+        // SSL流每次只加密第一个缓冲区, 先合并为连续的一段, 一条记录写完
+        const auto [ec, len] = co_await asio::async_write(socket(), batch.linearize());
+#else
+        const auto [ec, len] = co_await asio::async_write(socket(), batch.buffers());
+#endif
+        co_return ec;
+    }
 }
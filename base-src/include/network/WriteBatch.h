@@ -0,0 +1,61 @@
+#pragma once
+
+#include "base/base.export.h"
+#include "base/noncopy.h"
+
+#include <asio/buffer.hpp>
+#include <cstdint>
+#include <vector>
+
+
+namespace uranus::network {
+
+    /**
+     * 一次合并写入的缓冲区序列
+     * 头部等小块数据复制到内部存储, 大块载荷只记录引用, 调用者保证其在写入完成前有效;
+     * 相邻的内部存储合并为同一段, 减少writev的iovec数量
+     */
+    class BASE_API WriteBatch final {
+
+        struct Segment {
+            // 为nullptr时引用内部存储, offset有效
+            const uint8_t *data;
+            size_t offset;
+            size_t size;
+        };
+
+    public:
+        /// 不超过该长度的引用直接复制, 小包连续存放
+        static constexpr size_t kCopyThreshold = 256;
+
+        WriteBatch();
+        ~WriteBatch();
+
+        DISABLE_COPY_MOVE(WriteBatch)
+
+        /// 复制到内部存储
+        void append(const void *data, size_t size);
+
+        /// 引用外部数据
+        void reference(const void *data, size_t size);
+
+        [[nodiscard]] size_t bytes() const;
+        [[nodiscard]] bool empty() const;
+
+        /// 生成缓冲区序列, 在下一次修改之前有效
+        [[nodiscard]] const std::vector<asio::const_buffer> &buffers();
+
+        /// 复制为一段连续的数据, 用于不支持分散写入的流, 如SSL
+        [[nodiscard]] asio::const_buffer linearize();
+
+        void clear();
+
+    private:
+        std::vector<uint8_t> storage_;
+        std::vector<Segment> segments_;
+        std::vector<asio::const_buffer> buffers_;
+        std::vector<uint8_t> linear_;
+
+        size_t bytes_;
+    };
+}
@@ -1,4 +1,7 @@
 #include "MultiIOContextPool.h"
+#include "ThreadAffinity.h"
+
+#include <spdlog/spdlog.h>
 
 namespace uranus {
     MultiIOContextPool::PoolNode::PoolNode()
@@ -19,12 +22,20 @@ namespace uranus {
         }
     }
 
-    void MultiIOContextPool::start(const size_t capacity) {
+    void MultiIOContextPool::start(const size_t capacity, const std::vector<int> &cores) {
         pool_ = std::vector<PoolNode>(capacity);
-        for (auto &[th, ctx, guard]: pool_) {
+        for (size_t idx = 0; idx < pool_.size(); ++idx) {
+            auto &[th, ctx, guard] = pool_[idx];
             th = std::thread([&ctx] {
                 ctx.run();
             });
+
+            if (cores.empty())
+                continue;
+
+            if (const auto core = cores[idx % cores.size()]; !SetThreadAffinity(th, core)) {
+                SPDLOG_WARN("Failed to bind io thread[{}] to core {}", idx, core);
+            }
         }
     }
 
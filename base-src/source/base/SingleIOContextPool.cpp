@@ -1,4 +1,7 @@
 #include "SingleIOContextPool.h"
+#include "ThreadAffinity.h"
+
+#include <spdlog/spdlog.h>
 
 namespace uranus {
     SingleIOContextPool::SingleIOContextPool()
@@ -15,12 +18,20 @@ namespace uranus {
         }
     }
 
-    void SingleIOContextPool::start(size_t capacity) {
+    void SingleIOContextPool::start(size_t capacity, const std::vector<int> &cores) {
         pool_ = std::vector<std::thread>(capacity);
-        for (auto &val: pool_) {
+        for (size_t idx = 0; idx < pool_.size(); ++idx) {
+            auto &val = pool_[idx];
             val = std::thread([this]() {
                 ctx_.run();
             });
+
+            if (cores.empty())
+                continue;
+
+            if (const auto core = cores[idx % cores.size()]; !SetThreadAffinity(val, core)) {
+                SPDLOG_WARN("Failed to bind worker thread[{}] to core {}", idx, core);
+            }
         }
     }
 
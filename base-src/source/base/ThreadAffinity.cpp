@@ -0,0 +1,37 @@
+#include "ThreadAffinity.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+namespace uranus {
+
+    bool SetThreadAffinity(std::thread &th, const int core) {
+        if (core < 0 || !th.joinable())
+            return false;
+
+#if defined(_WIN32) || defined(_WIN64)
+        if (core >= static_cast<int>(sizeof(DWORD_PTR) * 8))
+            return false;
+
+        const auto mask = static_cast<DWORD_PTR>(1) << core;
+        return SetThreadAffinityMask(static_cast<HANDLE>(th.native_handle()), mask) != 0;
+#elif defined(__linux__)
+        if (core >= CPU_SETSIZE)
+            return false;
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(core, &set);
+
+        return pthread_setaffinity_np(th.native_handle(), sizeof(cpu_set_t), &set) == 0;
+#else
+        // macOS只提供亲和性提示, 不支持绑定到指定核心
+        return false;
+#endif
+    }
+}
@@ -0,0 +1,90 @@
+#include "WriteBatch.h"
+
+#include <cstring>
+
+namespace uranus::network {
+    WriteBatch::WriteBatch()
+        : bytes_(0) {
+    }
+
+    WriteBatch::~WriteBatch() {
+    }
+
+    void WriteBatch::append(const void *data, const size_t size) {
+        if (data == nullptr || size == 0)
+            return;
+
+        const auto offset = storage_.size();
+        storage_.resize(offset + size);
+        std::memcpy(storage_.data() + offset, data, size);
+
+        bytes_ += size;
+
+        // 与上一段内部存储相邻时合并
+        if (!segments_.empty()) {
+            if (auto &last = segments_.back(); last.data == nullptr && last.offset + last.size == offset) {
+                last.size += size;
+                return;
+            }
+        }
+
+        segments_.push_back({ nullptr, offset, size });
+    }
+
+    void WriteBatch::reference(const void *data, const size_t size) {
+        if (data == nullptr || size == 0)
+            return;
+
+        if (size <= kCopyThreshold) {
+            append(data, size);
+            return;
+        }
+
+        bytes_ += size;
+        segments_.push_back({ static_cast<const uint8_t *>(data), 0, size });
+    }
+
+    size_t WriteBatch::bytes() const {
+        return bytes_;
+    }
+
+    bool WriteBatch::empty() const {
+        return bytes_ == 0;
+    }
+
+    const std::vector<asio::const_buffer> &WriteBatch::buffers() {
+        buffers_.clear();
+        buffers_.reserve(segments_.size());
+
+        // 内部存储不再变化, 此时才能确定地址
+        for (const auto &seg : segments_) {
+            const auto *ptr = seg.data != nullptr ? seg.data : storage_.data() + seg.offset;
+            buffers_.emplace_back(ptr, seg.size);
+        }
+
+        return buffers_;
+    }
+
+    asio::const_buffer WriteBatch::linearize() {
+        if (segments_.size() == 1 && segments_.front().data == nullptr)
+            return { storage_.data(), storage_.size() };
+
+        linear_.resize(bytes_);
+
+        size_t offset = 0;
+        for (const auto &buf : buffers()) {
+            std::memcpy(linear_.data() + offset, buf.data(), buf.size());
+            offset += buf.size();
+        }
+
+        return { linear_.data(), linear_.size() };
+    }
+
+    void WriteBatch::clear() {
+        storage_.clear();
+        segments_.clear();
+        buffers_.clear();
+        linear_.clear();
+        bytes_ = 0;
+    }
+}
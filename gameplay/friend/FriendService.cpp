@@ -13,6 +13,7 @@ namespace gameplay {
 
     FriendService::FriendService() {
         enableTick_ = true;
+        mailboxBatch_ = 64;
     }
 
     FriendService::~FriendService() {
@@ -31,17 +32,28 @@ namespace gameplay {
     }
 
     void FriendService::onPackage(int64_t src, PackageHandle &&pkg) {
-        using namespace protocol;
+        if (pkg == nullptr)
+            return;
 
+        this->handlePackage(src, *pkg);
+    }
+
+    void FriendService::onMulticast(int64_t src, const SharedPackage &pkg) {
         if (pkg == nullptr)
             return;
 
+        this->handlePackage(src, *pkg);
+    }
+
+    void FriendService::handlePackage(int64_t src, const Package &pkg) {
+        using namespace protocol;
+
         auto logger = spdlog::get("friend_service");
 
-        switch (pkg->id_) {
+        switch (pkg.id_) {
             case kSyncPlayerInfo: {
                 greeting::SyncPlayerInfo info;
-                info.ParseFromArray(pkg->payload_.data(), pkg->payload_.size());
+                info.ParseFromArray(pkg.payload_.data(), pkg.payload_.size());
 
                 logger->info("Sync player[{}] info", src);
             }
@@ -52,6 +64,10 @@ namespace gameplay {
     }
 
     void FriendService::onEvent(int64_t evt, DataAsset *data) {
+        this->onEvent(evt, static_cast<const DataAsset *>(data));
+    }
+
+    void FriendService::onEvent(int64_t evt, const DataAsset *data) {
     }
 
     PackageHandle FriendService::onRequest(int64_t src, PackageHandle &&req) {
@@ -5,7 +5,9 @@
 namespace gameplay {
 
     using uranus::actor::BaseService;
+    using uranus::actor::Package;
     using uranus::actor::PackageHandle;
+    using uranus::actor::SharedPackage;
     using uranus::actor::DataAsset;
     using uranus::actor::ActorContext;
 
@@ -22,7 +24,13 @@ namespace gameplay {
         void onInitial(ActorContext *ctx) override;
 
         void onPackage(int64_t src, PackageHandle &&pkg) override;
+        void onMulticast(int64_t src, const SharedPackage &pkg) override;
         void onEvent(int64_t evt, DataAsset *data) override;
+        void onEvent(int64_t evt, const DataAsset *data) override;
         PackageHandle onRequest(int64_t src, PackageHandle &&req) override;
+
+    private:
+        /// 单播和多播共用, 只读取Package
+        void handlePackage(int64_t src, const Package &pkg);
     };
 } // gameplay
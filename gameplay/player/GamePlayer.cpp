@@ -73,7 +73,12 @@ namespace gameplay {
 
         // TODO: Other Info
 
-        sendToService("FriendService", protocol::kSyncPlayerInfo, info);
+        // 服务重启后地址失效, 重新解析
+        if (!friendService_) {
+            friendService_ = resolveService("FriendService");
+        }
+
+        sendToService(friendService_, protocol::kSyncPlayerInfo, info);
     }
 
     void GamePlayer::onLogout() {
@@ -10,8 +10,10 @@ namespace gameplay {
 
     using uranus::actor::BasePlayer;
     using uranus::actor::PackageHandle;
+    using uranus::actor::SharedPackage;
     using uranus::actor::DataAsset;
     using uranus::actor::ActorContext;
+    using uranus::actor::ActorRef;
     using google::protobuf::MessageLite;
 
     inline constexpr int kPlayerQueryResult = 1051;
@@ -34,7 +36,9 @@ namespace gameplay {
         void onLogout();
 
         void onPackage(int64_t src, PackageHandle &&pkg) override;
+        void onMulticast(int64_t src, const SharedPackage &pkg) override;
         void onEvent(int64_t evt, DataAsset *data) override;
+        void onEvent(int64_t evt, const DataAsset *data) override;
         PackageHandle onRequest(int64_t src, PackageHandle &&req) override;
 
         template<class T>
@@ -45,12 +49,18 @@ namespace gameplay {
         requires std::derived_from<T, MessageLite>
         void sendToService(const std::string &name, int64_t id, const T &msg) const;
 
+        template<class T>
+        requires std::derived_from<T, MessageLite>
+        void sendToService(const ActorRef &ref, int64_t id, const T &msg) const;
+
         [[nodiscard]] int64_t getPlayerId() const;
 
         ComponentModule &getComponentModule();
 
     private:
         ComponentModule component_;
+
+        ActorRef friendService_;
     };
 
     template<class T>
@@ -82,4 +92,21 @@ namespace gameplay {
 
         super::sendToService(name, std::move(pkg));
     }
+
+    template<class T>
+    requires std::derived_from<T, MessageLite>
+    void GamePlayer::sendToService(
+        const ActorRef &ref,
+        int64_t id,
+        const T &msg
+    ) const {
+        auto pkg = uranus::actor::Package::getHandle();
+
+        pkg->setId(id);
+
+        pkg->payload_.resize(msg.ByteSizeLong());
+        msg.SerializeToArray(pkg->payload_.data(), pkg->payload_.size());
+
+        super::sendToService(ref, std::move(pkg));
+    }
 }
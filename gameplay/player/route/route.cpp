@@ -29,7 +29,24 @@ namespace gameplay {
         }
     }
 
+    void GamePlayer::onMulticast(int64_t src, const SharedPackage &pkg) {
+        using namespace gameplay::protocol;
+
+        // 服务多播给所有目标玩家的同一份Package, 只读不复制
+        if (pkg == nullptr)
+            return;
+
+        switch (pkg->id_) {
+
+            default: break;
+        }
+    }
+
     void GamePlayer::onEvent(const int64_t evt, DataAsset *data) {
+        this->onEvent(evt, static_cast<const DataAsset *>(data));
+    }
+
+    void GamePlayer::onEvent(const int64_t evt, const DataAsset *data) {
         using event::EventType;
 
         switch (evt) {
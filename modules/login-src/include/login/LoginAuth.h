@@ -49,7 +49,8 @@ namespace uranus::login {
         void onLoginFailure(const FailureCallback &cb);
         void onPlayerLogout(const LogoutCallback &cb);
 
-        static void sendLoginSuccess(const shared_ptr<Connection> &conn, int64_t pid);
+        /// framing和compression为协商的结果, 本消息仍以默认格式发送
+        static void sendLoginSuccess(const shared_ptr<Connection> &conn, int64_t pid, uint32_t framing = 0, bool compression = false);
         static void sendLoginFailure(const shared_ptr<Connection> &conn, int64_t pid, const std::string &reason);
 
         static void sendLoginRepeated(const shared_ptr<Connection> &conn, int64_t pid, const std::string &address);
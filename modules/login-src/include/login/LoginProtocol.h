@@ -10,5 +10,6 @@ namespace uranus::login {
         kLogoutRequest = 1006,
         kLogoutResponse = 1007,
         kHeartbeat = 1008,
+        kLoginAck = 1009,
     };
 }
\ No newline at end of file
@@ -16,6 +16,6 @@ namespace uranus::login {
         nlohmann::json data;
 
     public:
-        DataAsset *clone() override;
+        DataAsset *clone() const override;
     };
 }
\ No newline at end of file
@@ -61,6 +61,10 @@ namespace uranus::login {
 
         const auto token = request.token();
 
+        // 请求的帧格式和压缩, 由网关决定是否接受
+        temp->attr().set("FRAMING", static_cast<int64_t>(request.framing()));
+        temp->attr().set("COMPRESSION", static_cast<bool>(request.compression()));
+
         if (pid <= 0) {
             SPDLOG_WARN("Client[{}] authentication failed", temp->remoteAddress().to_string());
             if (onFailure_) {
@@ -127,7 +131,9 @@ namespace uranus::login {
 
     void LoginAuth::sendLoginSuccess(
         const shared_ptr<Connection> &conn,
-        const int64_t pid
+        const int64_t pid,
+        const uint32_t framing,
+        const bool compression
     ) {
         if (conn == nullptr)
             return;
@@ -136,6 +142,8 @@ namespace uranus::login {
 
         ::login::LoginSuccess res;
         res.set_player_id(pid);
+        res.set_framing(framing);
+        res.set_compression(compression);
 
         pkg->setId(kLoginSuccess);
 
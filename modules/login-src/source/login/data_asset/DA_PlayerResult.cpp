@@ -1,7 +1,7 @@
 #include "data_asset/DA_PlayerResult.h"
 
 namespace uranus::login {
-    DataAsset *DA_PlayerResult::clone() {
+    DataAsset *DA_PlayerResult::clone() const {
         auto *res = new DA_PlayerResult();
         res->data = data;
         return res;
@@ -0,0 +1,237 @@
+#include "TestCheck.h"
+
+#include <actor/mailbox/ActorMailbox.h>
+
+#include <thread>
+#include <vector>
+
+
+using namespace uranus::actor;
+
+// 普通通道: source为生产者, session为序号
+static Envelope MakeNormal(const int64_t producer, const int64_t seq) {
+    return Envelope::makeRequest(0, producer, seq, nullptr);
+}
+
+// 优先通道
+static Envelope MakeUrgent(const int64_t seq) {
+    return Envelope::makeResponse(0, 0, seq, nullptr);
+}
+
+// 多个生产者并发写入, 每个生产者的信封按写入顺序取出, 不丢失也不重复
+static void TestProducerOrdering() {
+    constexpr int64_t kProducers = 4;
+    constexpr int64_t kCount = 20000;
+
+    ActorMailbox mailbox;
+    mailbox.setPolicy(MailboxPolicy::kGrow);
+
+    std::vector<std::thread> producers;
+    for (int64_t producer = 0; producer < kProducers; ++producer) {
+        producers.emplace_back([&mailbox, producer] {
+            for (int64_t seq = 0; seq < kCount; ++seq) {
+                CHECK(mailbox.push(MakeNormal(producer, seq)));
+            }
+        });
+    }
+
+    std::vector<int64_t> next(kProducers, 0);
+    int64_t received = 0;
+
+    while (received < kProducers * kCount) {
+        Envelope evl;
+        if (!mailbox.pop(evl))
+            continue;
+
+        CHECK_EQ(evl.type, Envelope::kRequest);
+        CHECK(evl.source >= 0 && evl.source < kProducers);
+        CHECK_EQ(evl.session, next[evl.source]);
+
+        ++next[evl.source];
+        ++received;
+    }
+
+    for (auto &thread : producers) {
+        thread.join();
+    }
+
+    Envelope evl;
+    CHECK(!mailbox.pop(evl));
+    CHECK_EQ(mailbox.size(), 0u);
+}
+
+// 响应, Tick和回调进入优先通道, 其余进入普通通道
+static void TestLaneClassification() {
+    CHECK(ActorMailbox::isUrgent(MakeUrgent(0)));
+    CHECK(ActorMailbox::isUrgent(Envelope::makeTickInfo({}, {})));
+    CHECK(ActorMailbox::isUrgent(Envelope::makeCallback([](BaseActor *) {})));
+
+    CHECK(!ActorMailbox::isUrgent(MakeNormal(0, 0)));
+    CHECK(!ActorMailbox::isUrgent(Envelope::makePackage(0, 0, nullptr)));
+    CHECK(!ActorMailbox::isUrgent(Envelope::makeDataAsset(0, nullptr)));
+}
+
+// 优先通道连续处理不超过上限, 普通通道有积压时必须让出
+static void TestStarvationBound() {
+    constexpr size_t kBound = 4;
+    constexpr int64_t kUrgent = 20;
+    constexpr int64_t kNormal = 5;
+
+    ActorMailbox mailbox;
+    mailbox.setStarvationBound(kBound);
+
+    for (int64_t seq = 0; seq < kNormal; ++seq) {
+        CHECK(mailbox.push(MakeNormal(0, seq)));
+    }
+    for (int64_t seq = 0; seq < kUrgent; ++seq) {
+        CHECK(mailbox.push(MakeUrgent(seq)));
+    }
+
+    int64_t urgent = 0;
+    int64_t normal = 0;
+    size_t streak = 0;
+
+    Envelope evl;
+    while (mailbox.pop(evl)) {
+        if (evl.type == Envelope::kResponse) {
+            CHECK_EQ(evl.session, urgent++);
+
+            // 普通通道还有信封时不能连续处理超过kBound条优先信封
+            if (normal < kNormal) {
+                CHECK(++streak <= kBound);
+            }
+        } else {
+            CHECK_EQ(evl.type, Envelope::kRequest);
+            CHECK_EQ(evl.session, normal++);
+
+            // 优先通道有积压时, 普通信封只在达到上限后出现
+            if (urgent < kUrgent) {
+                CHECK_EQ(streak, kBound);
+            }
+            streak = 0;
+        }
+    }
+
+    CHECK_EQ(urgent, kUrgent);
+    CHECK_EQ(normal, kNormal);
+}
+
+// 超出容量时拒绝新的信封, 两条通道各自计算容量
+static void TestRejectPolicy() {
+    ActorMailbox mailbox;
+    mailbox.setCapacity(2);
+    mailbox.setPolicy(MailboxPolicy::kReject);
+
+    CHECK(mailbox.push(MakeNormal(0, 0)));
+    CHECK(mailbox.push(MakeNormal(0, 1)));
+    CHECK(!mailbox.push(MakeNormal(0, 2)));
+    CHECK_EQ(mailbox.rejected(), 1u);
+    CHECK_EQ(mailbox.size(), 2u);
+
+    CHECK(mailbox.push(MakeUrgent(0)));
+    CHECK(mailbox.push(MakeUrgent(1)));
+    CHECK(!mailbox.push(MakeUrgent(2)));
+    CHECK_EQ(mailbox.rejected(), 2u);
+    CHECK_EQ(mailbox.size(), 4u);
+
+    // kGrow不限制优先通道
+    ActorMailbox unbounded;
+    unbounded.setCapacity(2);
+    unbounded.setPolicy(MailboxPolicy::kGrow);
+
+    for (int64_t seq = 0; seq < 5; ++seq) {
+        CHECK(unbounded.push(MakeUrgent(seq)));
+    }
+    CHECK_EQ(unbounded.rejected(), 0u);
+}
+
+// 取出时丢弃超出容量的最早的普通信封, 消费者停滞时积压不超过kDropOldestSlack倍容量
+static void TestDropOldestPolicy() {
+    ActorMailbox mailbox;
+    mailbox.setCapacity(2);
+    mailbox.setPolicy(MailboxPolicy::kDropOldest);
+
+    constexpr auto kLimit = static_cast<int64_t>(2 * ActorMailbox::kDropOldestSlack);
+
+    for (int64_t seq = 0; seq < kLimit; ++seq) {
+        CHECK(mailbox.push(MakeNormal(0, seq)));
+    }
+
+    CHECK(!mailbox.push(MakeNormal(0, kLimit)));
+    CHECK_EQ(mailbox.size(), static_cast<size_t>(kLimit));
+    CHECK_EQ(mailbox.dropped(), 1u);
+
+    Envelope evl;
+
+    CHECK(mailbox.pop(evl));
+    CHECK_EQ(evl.session, kLimit - 2);
+
+    CHECK(mailbox.pop(evl));
+    CHECK_EQ(evl.session, kLimit - 1);
+
+    CHECK(!mailbox.pop(evl));
+    CHECK_EQ(mailbox.dropped(), static_cast<size_t>(kLimit - 1));
+}
+
+// 达到高水位时拥塞, 降到低水位时只解除一次
+static void TestWatermark() {
+    ActorMailbox mailbox;
+    mailbox.setPolicy(MailboxPolicy::kGrow);
+    mailbox.setWatermark(4, 1);
+
+    for (int64_t seq = 0; seq < 3; ++seq) {
+        CHECK(mailbox.push(MakeNormal(0, seq)));
+    }
+    CHECK(!mailbox.congest());
+    CHECK(!mailbox.isCongested());
+
+    CHECK(mailbox.push(MakeNormal(0, 3)));
+    CHECK(mailbox.congest());
+    CHECK(mailbox.isCongested());
+
+    // 优先信封不计入水位
+    CHECK(mailbox.push(MakeUrgent(0)));
+
+    Envelope evl;
+
+    CHECK(mailbox.pop(evl));
+    CHECK(!mailbox.relieve());
+
+    CHECK(mailbox.pop(evl));
+    CHECK(!mailbox.relieve());
+
+    CHECK(mailbox.pop(evl));
+    CHECK(!mailbox.relieve());
+
+    CHECK(mailbox.pop(evl));
+    CHECK(mailbox.relieve());
+    CHECK(!mailbox.isCongested());
+    CHECK(!mailbox.relieve());
+}
+
+// 只有从空闲变为繁忙的那一次需要投递处理任务
+static void TestSchedule() {
+    ActorMailbox mailbox;
+
+    CHECK(mailbox.schedule());
+    CHECK(!mailbox.schedule());
+    CHECK(!mailbox.release());
+
+    CHECK(mailbox.schedule());
+    CHECK(mailbox.push(MakeNormal(0, 0)));
+
+    // 释放时仍有信封, 调度权留给调用者
+    CHECK(mailbox.release());
+    CHECK(!mailbox.schedule());
+}
+
+int main() {
+    TestProducerOrdering();
+    TestLaneClassification();
+    TestStarvationBound();
+    TestRejectPolicy();
+    TestDropOldestPolicy();
+    TestWatermark();
+    TestSchedule();
+    return 0;
+}
@@ -0,0 +1,231 @@
+#include "TestCheck.h"
+
+#include <actor/scheduler/ActorScheduler.h>
+#include <asio/post.hpp>
+#include <asio/strand.hpp>
+
+#include <array>
+#include <chrono>
+#include <set>
+#include <thread>
+#include <vector>
+
+
+using namespace uranus::actor;
+
+namespace {
+
+    using Strand = asio::strand<ActorScheduler::executor_type>;
+
+    void WaitFor(const std::atomic<int64_t> &counter, const int64_t expected) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+        while (counter.load() < expected) {
+            CHECK(std::chrono::steady_clock::now() < deadline);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    /// 记录构造和析构次数, 检查任务存储不泄漏也不重复析构
+    std::atomic<int64_t> kAlive = 0;
+
+    template<std::size_t Size>
+    struct Payload {
+        std::array<std::byte, Size> bytes{};
+        std::atomic<int64_t> *counter;
+
+        explicit Payload(std::atomic<int64_t> *ptr)
+            : counter(ptr) {
+            ++kAlive;
+        }
+
+        Payload(const Payload &rhs)
+            : counter(rhs.counter) {
+            ++kAlive;
+        }
+
+        Payload(Payload &&rhs) noexcept
+            : counter(rhs.counter) {
+            ++kAlive;
+        }
+
+        ~Payload() {
+            --kAlive;
+        }
+
+        void operator()() const {
+            counter->fetch_add(1);
+        }
+    };
+}
+
+// 外部线程并发投递到多个strand, 每个strand内按投递顺序执行且不并发
+static void TestExternalPostsKeepStrandOrder() {
+    constexpr int kPosters = 4;
+    constexpr int kStrands = 16;
+    constexpr int kCount = 5000;
+
+    ActorScheduler scheduler(4);
+    scheduler.start();
+
+    std::vector<Strand> strands;
+    for (int idx = 0; idx < kStrands; ++idx) {
+        strands.emplace_back(asio::make_strand(scheduler.get_executor()));
+    }
+
+    // 每个strand只由一个投递线程写入, 序号由该线程决定
+    std::vector<int64_t> next(kStrands, 0);
+    std::vector<std::atomic_bool> running(kStrands);
+    std::atomic<int64_t> done = 0;
+
+    std::vector<std::thread> posters;
+    for (int poster = 0; poster < kPosters; ++poster) {
+        posters.emplace_back([&, poster] {
+            for (int seq = 0; seq < kCount; ++seq) {
+                for (int idx = poster; idx < kStrands; idx += kPosters) {
+                    asio::post(strands[idx], [&, idx, seq] {
+                        CHECK(!running[idx].exchange(true));
+                        CHECK_EQ(next[idx], seq);
+                        ++next[idx];
+                        running[idx].store(false);
+                        ++done;
+                    });
+                }
+            }
+        });
+    }
+
+    for (auto &th : posters) {
+        th.join();
+    }
+
+    WaitFor(done, static_cast<int64_t>(kStrands) * kCount);
+    scheduler.stop();
+}
+
+// 外部投递分散到各线程的运行队列, 所有工作线程都参与执行
+static void TestExternalPostsSpreadAcrossWorkers() {
+    constexpr int kWorkers = 4;
+    constexpr int kCount = 4000;
+
+    ActorScheduler scheduler(kWorkers);
+
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::atomic<int64_t> done = 0;
+
+    // 启动前投递, 任务按轮转停留在各线程的队列中
+    for (int idx = 0; idx < kCount; ++idx) {
+        asio::post(scheduler.get_executor(), [&] {
+            {
+                std::lock_guard lock(mutex);
+                threads.insert(std::this_thread::get_id());
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(20));
+            ++done;
+        });
+    }
+
+    scheduler.start();
+    WaitFor(done, kCount);
+
+    CHECK_EQ(threads.size(), static_cast<size_t>(kWorkers));
+    scheduler.stop();
+}
+
+// 固定执行器的任务只在对应的工作线程上执行
+static void TestPinnedExecutor() {
+    ActorScheduler scheduler(3);
+    scheduler.start();
+
+    std::mutex mutex;
+    std::vector<std::set<std::thread::id>> threads(scheduler.size());
+    std::atomic<int64_t> done = 0;
+
+    for (int round = 0; round < 1000; ++round) {
+        for (size_t worker = 0; worker < scheduler.size(); ++worker) {
+            asio::post(scheduler.get_executor(worker), [&, worker] {
+                std::lock_guard lock(mutex);
+                threads[worker].insert(std::this_thread::get_id());
+                ++done;
+            });
+        }
+    }
+
+    WaitFor(done, 1000 * static_cast<int64_t>(scheduler.size()));
+
+    std::set<std::thread::id> all;
+    for (const auto &ids : threads) {
+        CHECK_EQ(ids.size(), 1u);
+        all.insert(*ids.begin());
+    }
+    CHECK_EQ(all.size(), scheduler.size());
+
+    scheduler.stop();
+}
+
+// 节点内存放的小任务和单独分配的大任务都恰好执行并析构一次, 停止时丢弃的任务也会析构
+static void TestTaskStorage() {
+    static_assert(sizeof(Payload<8>) <= SchedulerTask::kInlineSize);
+    static_assert(sizeof(Payload<256>) > SchedulerTask::kInlineSize);
+
+    std::atomic<int64_t> executed = 0;
+
+    {
+        ActorScheduler scheduler(2);
+        scheduler.start();
+
+        for (int idx = 0; idx < 1000; ++idx) {
+            asio::post(scheduler.get_executor(), Payload<8>(&executed));
+            asio::post(scheduler.get_executor(), Payload<256>(&executed));
+        }
+
+        WaitFor(executed, 2000);
+        scheduler.stop();
+    }
+
+    CHECK_EQ(kAlive.load(), 0);
+
+    std::atomic<int64_t> dropped = 0;
+
+    {
+        ActorScheduler scheduler(2);
+
+        // 未启动就停止, 队列中的任务不执行, 只析构
+        for (int idx = 0; idx < 100; ++idx) {
+            asio::post(scheduler.get_executor(), Payload<8>(&dropped));
+            asio::post(scheduler.get_executor(1), Payload<256>(&dropped));
+        }
+
+        scheduler.stop();
+    }
+
+    CHECK_EQ(dropped.load(), 0);
+    CHECK_EQ(kAlive.load(), 0);
+}
+
+// 工作线程全部休眠后, 外部投递能唤醒它们
+static void TestWakeUpAfterIdle() {
+    ActorScheduler scheduler(4);
+    scheduler.start();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    std::atomic<int64_t> done = 0;
+    for (int idx = 0; idx < 100; ++idx) {
+        asio::post(scheduler.get_executor(), [&] {
+            ++done;
+        });
+    }
+
+    WaitFor(done, 100);
+    scheduler.stop();
+}
+
+int main() {
+    TestExternalPostsKeepStrandOrder();
+    TestExternalPostsSpreadAcrossWorkers();
+    TestPinnedExecutor();
+    TestTaskStorage();
+    TestWakeUpAfterIdle();
+    return 0;
+}
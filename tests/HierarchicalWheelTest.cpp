@@ -0,0 +1,158 @@
+#include "TestCheck.h"
+
+#include <actor/timer/HierarchicalWheel.h>
+
+#include <algorithm>
+#include <memory>
+
+
+using namespace uranus::actor;
+
+namespace {
+
+    constexpr int64_t kRootSize = HierarchicalWheel::kRootSize;
+    constexpr int64_t kLevel0Span = int64_t(1) << 14;
+    constexpr int64_t kLevel1Span = int64_t(1) << 20;
+    constexpr int64_t kMaxSpan = HierarchicalWheel::kMaxSpan;
+
+    std::unique_ptr<WheelNode> MakeNode(HierarchicalWheel &wheel, const int64_t tick) {
+        auto node = std::make_unique<WheelNode>();
+        node->expire_ = tick;
+        wheel.insert(node.get());
+        return node;
+    }
+}
+
+// 单个节点跨越各层边界, 必须恰好在到期的那一格取出, 不提前也不推迟
+static void TestSingleCascade(const int64_t tick) {
+    HierarchicalWheel wheel;
+    const auto node = MakeNode(wheel, tick);
+
+    std::vector<WheelNode *> expired;
+
+    wheel.advance(tick - 1, expired);
+    CHECK(expired.empty());
+
+    wheel.advance(tick, expired);
+    CHECK_EQ(expired.size(), 1u);
+    CHECK(expired.front() == node.get());
+    CHECK(!HierarchicalWheel::linked(node.get()));
+    CHECK_EQ(wheel.size(), 0u);
+}
+
+// 多个节点分布在各层, 逐个推进到期时间, 每一格只取出对应的节点
+static void TestMixedCascade() {
+    const std::vector<int64_t> ticks = {
+        1, kRootSize - 1, kRootSize, kRootSize + 1,
+        kLevel0Span - 1, kLevel0Span, kLevel0Span + 1, kLevel0Span + kRootSize + 3,
+        kLevel1Span - 1, kLevel1Span, kLevel1Span + 300,
+        kMaxSpan - 1, kMaxSpan + 7,
+    };
+
+    HierarchicalWheel wheel;
+
+    // 乱序插入, 与插入顺序无关
+    std::vector<std::pair<int64_t, std::unique_ptr<WheelNode>>> nodes;
+    for (auto iter = ticks.rbegin(); iter != ticks.rend(); ++iter) {
+        nodes.emplace_back(*iter, MakeNode(wheel, *iter));
+    }
+    std::ranges::sort(nodes, {}, &std::pair<int64_t, std::unique_ptr<WheelNode>>::first);
+
+    std::vector<WheelNode *> expired;
+
+    for (const auto &[tick, node] : nodes) {
+        wheel.advance(tick - 1, expired);
+        CHECK(expired.empty());
+
+        wheel.advance(tick, expired);
+        CHECK_EQ(expired.size(), 1u);
+        CHECK(expired.front() == node.get());
+
+        expired.clear();
+    }
+
+    CHECK_EQ(wheel.size(), 0u);
+}
+
+// 移除的节点在级联前后都不会取出
+static void TestRemove() {
+    HierarchicalWheel wheel;
+
+    const auto kept = MakeNode(wheel, kLevel0Span + 5);
+    const auto removed = MakeNode(wheel, kLevel0Span + 5);
+    const auto late = MakeNode(wheel, kLevel1Span + 5);
+
+    wheel.remove(removed.get());
+    CHECK_EQ(wheel.size(), 2u);
+
+    std::vector<WheelNode *> expired;
+    wheel.advance(kLevel1Span, expired);
+    CHECK_EQ(expired.size(), 1u);
+    CHECK(expired.front() == kept.get());
+
+    // 已经级联到低层的节点同样可以移除
+    wheel.remove(late.get());
+    CHECK_EQ(wheel.size(), 0u);
+
+    expired.clear();
+    wheel.advance(2 * kLevel1Span, expired);
+    CHECK(expired.empty());
+}
+
+// 到期时间不晚于当前格的节点放到下一格, 空闲时可以直接对齐
+static void TestPastAndAlign() {
+    HierarchicalWheel wheel;
+    wheel.align(1000);
+    CHECK_EQ(wheel.current(), 1000);
+
+    const auto node = MakeNode(wheel, 10);
+    CHECK_EQ(node->expire_, 1001);
+
+    // 非空时不会跳过已有的节点
+    wheel.align(5000);
+    CHECK_EQ(wheel.current(), 1000);
+
+    std::vector<WheelNode *> expired;
+    wheel.advance(5000, expired);
+    CHECK_EQ(expired.size(), 1u);
+    CHECK_EQ(wheel.current(), 5000);
+}
+
+// clear()取出全部节点并断开链表
+static void TestClear() {
+    HierarchicalWheel wheel;
+
+    std::vector<std::unique_ptr<WheelNode>> nodes;
+    for (const auto tick : {int64_t(3), kLevel0Span, kMaxSpan * 3}) {
+        nodes.emplace_back(MakeNode(wheel, tick));
+    }
+
+    std::vector<WheelNode *> cleared;
+    wheel.clear(cleared);
+
+    CHECK_EQ(cleared.size(), nodes.size());
+    CHECK_EQ(wheel.size(), 0u);
+
+    for (const auto &node : nodes) {
+        CHECK(!HierarchicalWheel::linked(node.get()));
+        CHECK(std::ranges::find(cleared, node.get()) != cleared.end());
+    }
+}
+
+int main() {
+    for (const auto tick : {
+        int64_t(1), kRootSize - 1, kRootSize, kRootSize + 1,
+        kLevel0Span - 1, kLevel0Span, kLevel0Span + 1,
+        kLevel1Span - 1, kLevel1Span, kLevel1Span + 1,
+        kMaxSpan - 1, kMaxSpan, kMaxSpan + 1, 2 * kMaxSpan + 3,
+    }) {
+        TestSingleCascade(tick);
+    }
+
+    TestMixedCascade();
+    TestRemove();
+    TestPastAndAlign();
+    TestClear();
+
+    return 0;
+}
@@ -0,0 +1,338 @@
+#include "TestCheck.h"
+
+#include <actor/PackageFramer.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+using namespace uranus::actor;
+
+using Framing = PackageFramer::Framing;
+using ErrorCode = PackageFramer::ErrorCode;
+
+namespace {
+
+    using Bytes = std::vector<uint8_t>;
+
+    /// 模拟一次socket读取, 最多写入读缓冲区的空闲部分, 返回写入的字节数
+    size_t ReadSome(PackageFramer &framer, const uint8_t *data, const size_t size) {
+        const auto buffer = framer.prepare();
+        const auto len = std::min(buffer.size(), size);
+
+        std::memcpy(buffer.data(), data, len);
+        framer.commit(len);
+        return len;
+    }
+
+    /// 数据可以一次放进读缓冲区
+    void Feed(PackageFramer &framer, const Bytes &data) {
+        CHECK_EQ(ReadSome(framer, data.data(), data.size()), data.size());
+    }
+
+    /// 按发送端的格式和压缩设置编码一帧
+    Bytes Encode(PackageFramer &sender, const int64_t id, const Bytes &payload) {
+        auto pkg = Package::getHandle();
+        pkg->setId(id);
+        if (!payload.empty()) {
+            pkg->setData(payload.data(), payload.size());
+        }
+
+        error_code ec;
+        const auto compressed = sender.deflatePayload(*pkg, ec);
+        CHECK(!ec);
+
+        const auto &body = compressed ? sender.deflated() : Bytes(pkg->payload_.begin(), pkg->payload_.end());
+
+        uint8_t header[PackageFramer::kMaxHeaderSize];
+        const auto headerSize = PackageFramer::writeHeader(sender.getWriteFraming(), id, body.size(), compressed, header);
+
+        Bytes frame(header, header + headerSize);
+        frame.insert(frame.end(), body.begin(), body.end());
+        return frame;
+    }
+
+    /// 重复的结构, 压缩率高
+    Bytes MakePayload(const size_t size) {
+        Bytes payload(size);
+        for (size_t idx = 0; idx < size; ++idx) {
+            payload[idx] = static_cast<uint8_t>("player_info:"[idx % 12]);
+        }
+        return payload;
+    }
+
+    bool SamePayload(const Package &pkg, const Bytes &payload) {
+        return std::ranges::equal(pkg.payload_, payload);
+    }
+}
+
+// 固定头部声明的长度超过上限时, 只凭头部就报错, 不等待也不分配载荷
+static void TestFrameTooLarge() {
+    for (const size_t length : { size_t(1025), PackageFramer::kReadBufferSize * 4, size_t(1) << 40 }) {
+        PackageFramer framer;
+        framer.setMaxFrameSize(1024);
+
+        uint8_t header[PackageFramer::kMaxHeaderSize];
+        const auto headerSize = PackageFramer::writeHeader(Framing::kFixed, 7, length, false, header);
+        CHECK_EQ(headerSize, 16u);
+
+        Feed(framer, Bytes(header, header + headerSize));
+
+        error_code ec;
+        CHECK(framer.parse(ec) == nullptr);
+        CHECK(ec == ErrorCode::kFrameTooLarge);
+    }
+
+    // 恰好等于上限的帧正常解析
+    PackageFramer framer;
+    framer.setMaxFrameSize(1024);
+    Feed(framer, Encode(framer, 7, MakePayload(1024)));
+
+    error_code ec;
+    const auto pkg = framer.parse(ec);
+    CHECK(!ec);
+    CHECK(pkg != nullptr);
+    CHECK(SamePayload(*pkg, MakePayload(1024)));
+}
+
+// 10字节都带有继续标记的varint是格式错误, 不足10字节时继续等待
+static void TestMalformedVarint() {
+    PackageFramer framer;
+    framer.setReadFraming(Framing::kCompact);
+
+    Feed(framer, Bytes(9, 0x80));
+
+    error_code ec;
+    CHECK(framer.parse(ec) == nullptr);
+    CHECK(!ec);
+
+    Feed(framer, Bytes(1, 0x80));
+
+    CHECK(framer.parse(ec) == nullptr);
+    CHECK(ec == ErrorCode::kMalformedHeader);
+
+    // 长度字段同样检查
+    PackageFramer other;
+    other.setReadFraming(Framing::kCompact);
+
+    Bytes frame = { 0x05 };
+    frame.insert(frame.end(), 10, 0xFF);
+    Feed(other, frame);
+
+    ec.clear();
+    CHECK(other.parse(ec) == nullptr);
+    CHECK(ec == ErrorCode::kMalformedHeader);
+}
+
+// 紧凑格式编码后逐个解析, 一次到达和逐字节到达结果相同
+static void TestCompactRoundTrip() {
+    const std::vector<std::pair<int64_t, Bytes>> frames = {
+        { 5, MakePayload(3) },
+        { 300, Bytes{} },
+        { 1051, MakePayload(200) },
+        { int64_t(1) << 40, MakePayload(PackageFramer::kReadBufferSize - 64) },
+        { -1, MakePayload(17) },
+    };
+
+    for (const size_t chunk : { SIZE_MAX, size_t(1), size_t(7) }) {
+        PackageFramer sender;
+        sender.setWriteFraming(Framing::kCompact);
+
+        PackageFramer receiver;
+        receiver.setReadFraming(Framing::kCompact);
+
+        Bytes stream;
+        for (const auto &[id, payload] : frames) {
+            const auto frame = Encode(sender, id, payload);
+            stream.insert(stream.end(), frame.begin(), frame.end());
+        }
+
+        size_t offset = 0;
+        size_t parsed = 0;
+
+        while (parsed < frames.size()) {
+            error_code ec;
+            if (const auto pkg = receiver.parse(ec)) {
+                CHECK_EQ(pkg->id_, frames[parsed].first);
+                CHECK(SamePayload(*pkg, frames[parsed].second));
+                ++parsed;
+                continue;
+            }
+
+            CHECK(!ec);
+            CHECK(offset < stream.size());
+
+            const auto len = ReadSome(receiver, stream.data() + offset, std::min(chunk, stream.size() - offset));
+            CHECK(len > 0);
+            offset += len;
+        }
+
+        CHECK_EQ(offset, stream.size());
+    }
+
+    // 小id的短包头部只有2字节
+    uint8_t header[PackageFramer::kMaxHeaderSize];
+    CHECK_EQ(PackageFramer::writeHeader(Framing::kCompact, 5, 3, false, header), 2u);
+}
+
+// 同一条流上的两条消息共享字典, 第二条压缩得更小, 都能还原
+static void TestDeflateRoundTrip() {
+    PackageFramer sender;
+    sender.setCompressionOptions({ 64, 6, 15 });
+    sender.setWriteCompression(true);
+
+    PackageFramer receiver;
+    receiver.setReadCompression(true);
+
+    const auto payload = MakePayload(4000);
+
+    const auto first = Encode(sender, 1, payload);
+    const auto second = Encode(sender, 2, payload);
+
+    CHECK(first.size() < payload.size());
+    CHECK(second.size() < first.size());
+
+    // 低于阈值的载荷不压缩, 与压缩的帧混在同一条流中
+    const auto small = Encode(sender, 3, MakePayload(10));
+    CHECK_EQ(small.size(), 16u + 10u);
+
+    Bytes stream = first;
+    stream.insert(stream.end(), small.begin(), small.end());
+    stream.insert(stream.end(), second.begin(), second.end());
+    Feed(receiver, stream);
+
+    error_code ec;
+
+    const auto pkg1 = receiver.parse(ec);
+    CHECK(!ec && pkg1 != nullptr);
+    CHECK_EQ(pkg1->id_, 1);
+    CHECK(SamePayload(*pkg1, payload));
+
+    const auto pkg3 = receiver.parse(ec);
+    CHECK(!ec && pkg3 != nullptr);
+    CHECK_EQ(pkg3->id_, 3);
+    CHECK(SamePayload(*pkg3, MakePayload(10)));
+
+    const auto pkg2 = receiver.parse(ec);
+    CHECK(!ec && pkg2 != nullptr);
+    CHECK_EQ(pkg2->id_, 2);
+    CHECK(SamePayload(*pkg2, payload));
+}
+
+// 没有协商压缩时收到压缩帧直接报错
+static void TestCompressedNotNegotiated() {
+    for (const auto framing : { Framing::kFixed, Framing::kCompact }) {
+        PackageFramer sender;
+        sender.setWriteFraming(framing);
+        sender.setWriteCompression(true);
+
+        PackageFramer receiver;
+        receiver.setReadFraming(framing);
+
+        Feed(receiver, Encode(sender, 1, MakePayload(2000)));
+
+        error_code ec;
+        CHECK(receiver.parse(ec) == nullptr);
+        CHECK(ec == ErrorCode::kDecompress);
+    }
+}
+
+// 压缩后很小但解压后超过上限的载荷, 解压到上限时停止
+static void TestInflateBomb() {
+    PackageFramer sender;
+    sender.setWriteCompression(true);
+
+    const auto frame = Encode(sender, 1, Bytes(1 << 20, 0));
+
+    constexpr size_t kLimit = 64 * 1024;
+    CHECK(frame.size() < kLimit);
+
+    PackageFramer receiver;
+    receiver.setMaxFrameSize(kLimit);
+    receiver.setReadCompression(true);
+
+    Feed(receiver, frame);
+
+    error_code ec;
+    CHECK(receiver.parse(ec) == nullptr);
+    CHECK(ec == ErrorCode::kFrameTooLarge);
+
+    // 直接解压同样受限
+    auto pkg = Package::getHandle();
+    const auto &body = sender.deflated();
+    CHECK(sender.deflated().size() + 16 == frame.size());
+
+    PackageFramer other;
+    other.setMaxFrameSize(kLimit);
+    CHECK(other.inflatePayload(body.data(), body.size(), *pkg) == ErrorCode::kFrameTooLarge);
+    CHECK(pkg->payload_.empty());
+}
+
+// 解压后恰好等于上限的载荷与未压缩的帧一样被接受, 多一个字节就拒绝
+static void TestInflateAtLimit() {
+    constexpr size_t kLimit = 64 * 1024;
+
+    for (const size_t size : { kLimit, kLimit + 1 }) {
+        PackageFramer sender;
+        sender.setWriteCompression(true);
+
+        PackageFramer receiver;
+        receiver.setMaxFrameSize(kLimit);
+        receiver.setReadCompression(true);
+
+        const auto payload = MakePayload(size);
+        const auto frame = Encode(sender, 1, payload);
+        CHECK(frame.size() < kLimit);
+
+        Feed(receiver, frame);
+
+        error_code ec;
+        const auto pkg = receiver.parse(ec);
+
+        if (size == kLimit) {
+            CHECK(!ec);
+            CHECK(pkg != nullptr);
+            CHECK(SamePayload(*pkg, payload));
+        } else {
+            CHECK(pkg == nullptr);
+            CHECK(ec == ErrorCode::kFrameTooLarge);
+        }
+    }
+
+    // 流中的下一帧不受影响
+    PackageFramer sender;
+    sender.setWriteCompression(true);
+
+    PackageFramer receiver;
+    receiver.setMaxFrameSize(kLimit);
+    receiver.setReadCompression(true);
+
+    Bytes stream = Encode(sender, 1, MakePayload(kLimit));
+    const auto next = Encode(sender, 2, MakePayload(100));
+    stream.insert(stream.end(), next.begin(), next.end());
+    Feed(receiver, stream);
+
+    error_code ec;
+    const auto first = receiver.parse(ec);
+    CHECK(!ec && first != nullptr);
+    CHECK(SamePayload(*first, MakePayload(kLimit)));
+
+    const auto second = receiver.parse(ec);
+    CHECK(!ec && second != nullptr);
+    CHECK_EQ(second->id_, 2);
+    CHECK(SamePayload(*second, MakePayload(100)));
+}
+
+int main() {
+    TestFrameTooLarge();
+    TestMalformedVarint();
+    TestCompactRoundTrip();
+    TestDeflateRoundTrip();
+    TestCompressedNotNegotiated();
+    TestInflateBomb();
+    TestInflateAtLimit();
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include "TestCheck.h"
+
+#include <base/Recycler.h>
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+
+using namespace uranus;
+
+namespace {
+
+    std::atomic<int64_t> kAlive = 0;
+
+    class Node;
+    DECLARE_RECYCLER(Node)
+
+    class Node final {
+
+        DECLARE_RECYCLER_GET(Node)
+
+        explicit Node(const NodeRecyclerHandle &handle)
+            : handle_(handle) {
+            ++kAlive;
+        }
+
+    public:
+        ~Node() {
+            --kAlive;
+        }
+
+        void recycle() {
+            handle_.recycle(this);
+        }
+
+    private:
+        NodeRecyclerHandle handle_;
+    };
+
+    IMPLEMENT_RECYCLER_GET(Node)
+    IMPLEMENT_RECYCLER(Node)
+
+    constexpr int64_t kCapacity = 64;
+
+    /// 取空本线程的空闲栈
+    std::vector<Node *> AcquireAll() {
+        std::vector<Node *> nodes;
+        for (int64_t idx = 0; idx < kCapacity; ++idx) {
+            nodes.push_back(Node::get());
+        }
+        return nodes;
+    }
+}
+
+// 同一线程回收后立即复用
+static void TestLocalReuse() {
+    auto *node = Node::get();
+    node->recycle();
+
+    CHECK(Node::get() == node);
+    node->recycle();
+}
+
+// 其他线程回收的对象还给创建它的线程, 不再新建
+static void TestCrossThreadReturn() {
+    const auto alive = kAlive.load();
+    const auto nodes = AcquireAll();
+
+    std::thread([&nodes] {
+        for (auto *node : nodes) {
+            node->recycle();
+        }
+    }).join();
+
+    const std::set<Node *> expected(nodes.begin(), nodes.end());
+    const auto again = AcquireAll();
+
+    CHECK(std::set<Node *>(again.begin(), again.end()) == expected);
+    CHECK_EQ(kAlive.load(), alive);
+
+    for (auto *node : again) {
+        node->recycle();
+    }
+}
+
+// 线程退出时释放它的空闲对象, 之后归还给它的对象直接释放
+static void TestThreadExit() {
+    const auto alive = kAlive.load();
+
+    Node *orphan = nullptr;
+
+    std::thread([&orphan] {
+        orphan = Node::get();
+
+        for (auto *node : AcquireAll()) {
+            node->recycle();
+        }
+    }).join();
+
+    CHECK_EQ(kAlive.load(), alive + 1);
+
+    orphan->recycle();
+    CHECK_EQ(kAlive.load(), alive);
+}
+
+// 多个线程互相回收, 对象总数不超过各线程的池容量
+static void TestConcurrentRecycle() {
+    constexpr int kThreads = 4;
+    constexpr int kRounds = 2000;
+
+    std::vector<ConcurrentQueue<Node *>> mailboxes(kThreads);
+    std::vector<std::thread> threads;
+
+    for (int idx = 0; idx < kThreads; ++idx) {
+        threads.emplace_back([&mailboxes, idx] {
+            auto &next = mailboxes[(idx + 1) % kThreads];
+            auto &self = mailboxes[idx];
+
+            for (int round = 0; round < kRounds; ++round) {
+                for (int num = 0; num < 8; ++num) {
+                    next.enqueue(Node::get());
+                }
+
+                Node *node = nullptr;
+                while (self.try_dequeue(node)) {
+                    node->recycle();
+                }
+            }
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (auto &mailbox : mailboxes) {
+        Node *node = nullptr;
+        while (mailbox.try_dequeue(node)) {
+            node->recycle();
+        }
+    }
+}
+
+int main() {
+    TestLocalReuse();
+    TestCrossThreadReturn();
+    TestThreadExit();
+    TestConcurrentRecycle();
+    return 0;
+}
@@ -0,0 +1,153 @@
+#include "TestCheck.h"
+#include "StubActorContext.h"
+
+#include <actor/session/SessionManager.h>
+#include <asio/io_context.hpp>
+#include <asio/bind_executor.hpp>
+
+#include <thread>
+
+
+using namespace uranus::actor;
+
+namespace {
+
+    struct Result {
+        int calls = 0;
+        bool response = false;
+    };
+
+    /// 没有待处理的工作时poll()会让io_context进入停止状态, 每次先restart()
+    void Drain(asio::io_context &ctx) {
+        ctx.restart();
+        ctx.poll();
+    }
+
+    /// 回调绑定到io_context, 由poll()执行, 结果与调用顺序无关
+    SessionHandler MakeHandler(asio::io_context &ctx, Result &result) {
+        return asio::bind_executor(ctx, [&result](PackageHandle res) {
+            ++result.calls;
+            result.response = res != nullptr;
+        });
+    }
+}
+
+// 会话完成后槽位被复用, 旧id不能再完成新的会话
+static void TestStaleIdAfterReuse(asio::io_context &ctx, SessionManager &mgr) {
+    Result first, second;
+
+    const auto id1 = mgr.pushSession(MakeHandler(ctx, first));
+    CHECK(id1 > 0);
+    CHECK_EQ(mgr.size(), 1u);
+
+    mgr.dispatch(id1, Package::getHandle());
+    Drain(ctx);
+
+    CHECK_EQ(first.calls, 1);
+    CHECK(first.response);
+    CHECK_EQ(mgr.size(), 0u);
+
+    const auto id2 = mgr.pushSession(MakeHandler(ctx, second));
+    CHECK_EQ(RequestSession::indexOf(id2), RequestSession::indexOf(id1));
+    CHECK(id2 != id1);
+
+    // 迟到的响应和重复的取消都被忽略
+    mgr.dispatch(id1, Package::getHandle());
+    mgr.cancel(id1);
+    Drain(ctx);
+
+    CHECK_EQ(first.calls, 1);
+    CHECK_EQ(second.calls, 0);
+    CHECK_EQ(mgr.size(), 1u);
+
+    mgr.cancel(id2);
+    Drain(ctx);
+
+    CHECK_EQ(second.calls, 1);
+    CHECK(!second.response);
+    CHECK_EQ(mgr.size(), 0u);
+}
+
+// 代数用完31位后回到1, id始终为正数, 回绕前的id不会命中回绕后的会话
+static void TestGenerationWrap() {
+    constexpr uint32_t kLast = 0x7FFFFFFF;
+    constexpr uint32_t kIndex = 42;
+
+    CHECK_EQ(RequestSession::nextGeneration(1), 2u);
+    CHECK_EQ(RequestSession::nextGeneration(kLast), 1u);
+
+    const auto lastId = RequestSession::makeId(kIndex, kLast);
+    const auto wrappedId = RequestSession::makeId(kIndex, RequestSession::nextGeneration(kLast));
+
+    CHECK(lastId > 0);
+    CHECK(wrappedId > 0);
+    CHECK(wrappedId != lastId);
+
+    CHECK_EQ(RequestSession::indexOf(lastId), kIndex);
+    CHECK_EQ(RequestSession::generationOf(lastId), kLast);
+    CHECK_EQ(RequestSession::indexOf(wrappedId), kIndex);
+    CHECK_EQ(RequestSession::generationOf(wrappedId), 1u);
+}
+
+// 到期的会话以空响应完成, 未到期的保留
+static void TestTimeout(asio::io_context &ctx, SessionManager &mgr) {
+    Result expired, alive;
+
+    const auto now = std::chrono::steady_clock::now();
+
+    mgr.pushSession(MakeHandler(ctx, alive), now + std::chrono::hours(1));
+    mgr.pushSession(MakeHandler(ctx, expired), now + std::chrono::milliseconds(20));
+    CHECK_EQ(mgr.size(), 2u);
+
+    while (expired.calls == 0) {
+        ctx.restart();
+        ctx.run_one_for(std::chrono::milliseconds(100));
+    }
+
+    CHECK(!expired.response);
+    CHECK_EQ(alive.calls, 0);
+    CHECK_EQ(mgr.size(), 1u);
+
+    mgr.cancelAll();
+    Drain(ctx);
+
+    CHECK_EQ(alive.calls, 1);
+    CHECK(!alive.response);
+    CHECK_EQ(mgr.size(), 0u);
+}
+
+// 上下文停止后不再创建会话, 回调立即以空响应完成
+static void TestNotRunning(asio::io_context &ctx, SessionManager &mgr, StubActorContext &owner) {
+    Result result;
+
+    owner.running = false;
+
+    CHECK_EQ(mgr.pushSession(MakeHandler(ctx, result)), -1);
+    Drain(ctx);
+
+    CHECK_EQ(result.calls, 1);
+    CHECK(!result.response);
+    CHECK_EQ(mgr.size(), 0u);
+
+    owner.running = true;
+}
+
+int main() {
+    asio::io_context ctx;
+
+    const auto owner = std::make_shared<StubActorContext>(ctx.get_executor());
+
+    {
+        SessionManager mgr(*owner);
+
+        TestStaleIdAfterReuse(ctx, mgr);
+        TestGenerationWrap();
+        TestTimeout(ctx, mgr);
+        TestNotRunning(ctx, mgr, *owner);
+
+        mgr.cancelAll();
+        Drain(ctx);
+    }
+
+    return 0;
+}
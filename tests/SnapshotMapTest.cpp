@@ -0,0 +1,260 @@
+#include "TestCheck.h"
+
+#include <base/SnapshotMap.h>
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+    using Table = SnapshotMap<int64_t, std::shared_ptr<const std::string>>;
+
+    std::shared_ptr<const std::string> MakeValue(const int64_t key, const int gen) {
+        return std::make_shared<const std::string>(std::to_string(key) + ":" + std::to_string(gen));
+    }
+
+    /// 在另一个线程上执行func并等待完成, 之后该线程保持空闲, 不再查询
+    class IdleThread final {
+
+    public:
+        IdleThread() : thread_([this] { loop(); }) {}
+
+        ~IdleThread() {
+            {
+                std::lock_guard lock(mutex_);
+                stop_ = true;
+            }
+            cv_.notify_all();
+            thread_.join();
+        }
+
+        void run(std::function<void()> func) {
+            std::unique_lock lock(mutex_);
+            task_ = std::move(func);
+            cv_.notify_all();
+            cv_.wait(lock, [this] { return task_ == nullptr; });
+        }
+
+    private:
+        void loop() {
+            std::unique_lock lock(mutex_);
+            while (true) {
+                cv_.wait(lock, [this] { return stop_ || task_ != nullptr; });
+                if (stop_)
+                    return;
+
+                task_();
+                task_ = nullptr;
+                cv_.notify_all();
+            }
+        }
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::function<void()> task_;
+        bool stop_ = false;
+
+        std::thread thread_;
+    };
+}
+
+// 多个写线程插入并删除各自的键, 读线程同时查询, 只能看到完整写入的值
+static void TestConcurrentAccess() {
+    constexpr int64_t kWriters = 4;
+    constexpr int64_t kKeys = 2000;
+
+    Table table;
+    std::atomic_bool done = false;
+
+    std::vector<std::thread> readers;
+    for (int idx = 0; idx < 4; ++idx) {
+        readers.emplace_back([&table, &done] {
+            while (!done.load(std::memory_order_acquire)) {
+                for (int64_t key = 0; key < kWriters * kKeys; key += 7) {
+                    if (const auto *val = table.find(key)) {
+                        CHECK(*val != nullptr);
+                        CHECK((*val)->starts_with(std::to_string(key) + ":"));
+                    }
+                }
+            }
+        });
+    }
+
+    std::vector<std::thread> writers;
+    for (int64_t writer = 0; writer < kWriters; ++writer) {
+        writers.emplace_back([&table, writer] {
+            const auto begin = writer * kKeys;
+            for (int64_t key = begin; key < begin + kKeys; ++key) {
+                CHECK(table.insert_or_assign(key, MakeValue(key, 1)) == nullptr);
+            }
+
+            // 覆盖奇数键, 删除偶数键
+            for (int64_t key = begin; key < begin + kKeys; ++key) {
+                if (key % 2 == 0) {
+                    CHECK(table.erase(key) != nullptr);
+                } else {
+                    CHECK(*table.insert_or_assign(key, MakeValue(key, 2)) == std::to_string(key) + ":1");
+                }
+            }
+        });
+    }
+
+    for (auto &thread : writers) {
+        thread.join();
+    }
+
+    done.store(true, std::memory_order_release);
+    for (auto &thread : readers) {
+        thread.join();
+    }
+
+    CHECK_EQ(table.size(), static_cast<size_t>(kWriters * kKeys / 2));
+
+    // 写入完成后任何线程都能看到最终的结果
+    std::thread([&table] {
+        for (int64_t key = 0; key < kWriters * kKeys; ++key) {
+            const auto *val = table.find(key);
+            if (key % 2 == 0) {
+                CHECK(val == nullptr);
+            } else {
+                CHECK(val != nullptr);
+                CHECK(**val == std::to_string(key) + ":2");
+            }
+        }
+    }).join();
+
+    size_t visited = 0;
+    table.forEach([&visited](const int64_t key, const auto &val) {
+        CHECK(key % 2 == 1);
+        CHECK(*val == std::to_string(key) + ":2");
+        ++visited;
+    });
+    CHECK_EQ(visited, table.size());
+}
+
+// 借用的指针在版本号变化后仍然指向旧快照中的值, 直到本线程再次查询同一分片
+static void TestStaleSnapshot() {
+    Table table;
+    table.insert_or_assign(1, MakeValue(1, 1));
+
+    IdleThread reader;
+
+    const std::shared_ptr<const std::string> *borrowed = nullptr;
+    reader.run([&] {
+        borrowed = table.find(1);
+    });
+
+    CHECK(borrowed != nullptr);
+    std::weak_ptr<const std::string> weak = *borrowed;
+
+    // 覆盖和删除都不影响读线程已经借出的指针
+    table.insert_or_assign(1, MakeValue(1, 2));
+    CHECK_EQ(**borrowed, std::string("1:1"));
+
+    table.erase(1);
+    CHECK_EQ(**borrowed, std::string("1:1"));
+    CHECK(!weak.expired());
+
+    // 读线程再次查询后刷新快照, 旧值随之释放
+    reader.run([&] {
+        CHECK(table.find(1) == nullptr);
+    });
+    CHECK(weak.expired());
+
+    table.insert_or_assign(1, MakeValue(1, 3));
+    reader.run([&] {
+        const auto *val = table.find(1);
+        CHECK(val != nullptr);
+        CHECK_EQ(**val, std::string("1:3"));
+    });
+}
+
+// 空闲线程的本地快照持有已删除的值, purge()后释放
+static void TestPurge() {
+    Table table;
+    table.insert_or_assign(1, MakeValue(1, 1));
+
+    std::weak_ptr<const std::string> weak;
+
+    IdleThread reader;
+    reader.run([&] {
+        const auto *val = table.find(1);
+        CHECK(val != nullptr);
+        weak = *val;
+    });
+
+    table.erase(1);
+    CHECK_EQ(table.size(), 0u);
+    CHECK(!weak.expired());
+
+    table.purge();
+    CHECK(weak.expired());
+
+    // purge()之后读线程重新获取快照
+    table.insert_or_assign(1, MakeValue(1, 2));
+    reader.run([&] {
+        const auto *val = table.find(1);
+        CHECK(val != nullptr);
+        CHECK_EQ(**val, std::string("1:2"));
+    });
+}
+
+// 同一线程交替查询同类型的两个实例, 各自的本地快照互不替换, 借用的指针保持有效
+static void TestInterleavedInstances() {
+    Table first;
+    first.insert_or_assign(1, MakeValue(1, 1));
+
+    const std::shared_ptr<const std::string> *borrowed = nullptr;
+    std::weak_ptr<const std::string> weak;
+
+    {
+        Table second;
+        second.insert_or_assign(1, MakeValue(1, 10));
+
+        for (int round = 0; round < 3; ++round) {
+            borrowed = first.find(1);
+            CHECK(borrowed != nullptr);
+            CHECK_EQ(**borrowed, std::string("1:1"));
+
+            const auto *other = second.find(1);
+            CHECK(other != nullptr);
+            CHECK_EQ(**other, std::string("1:10"));
+        }
+
+        weak = *borrowed;
+
+        // 写线程替换first的快照后, 本线程持有的旧快照仍然有效
+        std::thread([&first] {
+            first.erase(1);
+        }).join();
+
+        CHECK(second.find(1) != nullptr);
+        CHECK_EQ(**borrowed, std::string("1:1"));
+        CHECK(!weak.expired());
+    }
+
+    // second析构后, 新的实例复用它的本地缓存槽位
+    Table third;
+    third.insert_or_assign(2, MakeValue(2, 1));
+    CHECK(third.find(2) != nullptr);
+    CHECK(third.find(1) == nullptr);
+
+    CHECK_EQ(**borrowed, std::string("1:1"));
+
+    CHECK(first.find(1) == nullptr);
+    CHECK(weak.expired());
+}
+
+int main() {
+    TestConcurrentAccess();
+    TestStaleSnapshot();
+    TestPurge();
+    TestInterleavedInstances();
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <actor/BaseActor.h>
+#include <actor/BaseActorContext.h>
+
+
+namespace uranus::actor {
+
+    /// 什么都不做的Actor, 只用于构造上下文
+    class StubActor final : public BaseActor {
+
+    public:
+        void onPackage(int64_t, PackageHandle &&) override {}
+        void onEvent(int64_t, DataAsset *) override {}
+
+        PackageHandle onRequest(int64_t, PackageHandle &&) override {
+            return nullptr;
+        }
+    };
+
+    /**
+     * 不依赖GameWorld的上下文, 供需要BaseActorContext的组件单独测试
+     * 不调用run(), 由running控制isRunning()的结果
+     */
+    class StubActorContext final : public BaseActorContext {
+
+    public:
+        explicit StubActorContext(const asio::any_io_executor &exec)
+            : BaseActorContext(exec, ActorHandle(new StubActor(), [](BaseActor *ptr) { delete ptr; })) {
+        }
+
+        [[nodiscard]] bool isRunning() const override {
+            return running;
+        }
+
+        [[nodiscard]] ServerModule *getModule(const string &) const override {
+            return nullptr;
+        }
+
+        [[nodiscard]] ActorMap getActorMap(const string &) const override {
+            return {};
+        }
+
+        [[nodiscard]] int64_t queryActorId(const string &, const string &) const override {
+            return -1;
+        }
+
+        [[nodiscard]] ActorRef resolve(int, int64_t) const override {
+            return {};
+        }
+
+        void send(int, int64_t, PackageHandle &&) override {}
+        void send(const ActorRef &, PackageHandle &&) override {}
+        void multicast(int, const std::set<int64_t> &, PackageHandle &&) override {}
+
+        void listen(int64_t, bool) override {}
+        void dispatch(int64_t, DataAssetHandle &&) override {}
+
+        bool running = true;
+
+    protected:
+        void createCommand(const string &, DataAssetHandle &&, CommandHandler &&) override {}
+
+        void sendRequest(int, int64_t, int64_t, PackageHandle &&, SteadyTimePoint) override {}
+        void sendResponse(int, int64_t, int64_t, PackageHandle &&) override {}
+    };
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+
+
+/// Release下assert会被移除, 单元测试统一使用CHECK, 失败时打印位置并以非零值退出
+#define CHECK(expr) \
+    do { \
+        if (!(expr)) { \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr); \
+            std::exit(1); \
+        } \
+    } while (false)
+
+#define CHECK_EQ(lhs, rhs) CHECK((lhs) == (rhs))
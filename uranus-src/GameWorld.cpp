@@ -5,6 +5,8 @@
 #include <ranges>
 #include <format>
 #include <asio/signal_set.hpp>
+#include <asio/co_spawn.hpp>
+#include <asio/detached.hpp>
 #include <yaml-cpp/yaml.h>
 #include <spdlog/spdlog.h>
 
@@ -13,7 +15,9 @@ using uranus::config::ConfigModule;
 
 namespace uranus {
     GameWorld::GameWorld()
-        : guard_(asio::make_work_guard(ctx_)) {
+        : guard_(asio::make_work_guard(ctx_)),
+          rebalancer_(ctx_),
+          quota_(0) {
     }
 
     GameWorld::~GameWorld() {
@@ -21,13 +25,12 @@ namespace uranus {
     }
 
     void GameWorld::run() {
-        for (const auto &val : ordered_) {
-            SPDLOG_INFO("Start module: {}", val->getModuleName());
-            val->start();
-        }
-
         int num = 0;
 
+        SteadyDuration migrateInterval = SteadyDuration::zero();
+        double migrateRatio = 1.5;
+        size_t migrateBacklog = 0;
+
         {
             const auto *config = GET_MODULE(this, ConfigModule);
             if (!config) {
@@ -37,13 +40,61 @@ namespace uranus {
 
             // Get global server config
             const auto &cfg = config->getServerConfig();
+            const auto &worker = cfg["server"]["worker"];
 
             // Read the worker threads number
-            num = cfg["server"]["worker"]["threads"].as<int>();
+            num = worker["threads"].as<int>();
+
+            // Must be decided before the modules create any actor
+            if (worker["scheduler"] && worker["scheduler"].as<std::string>() == "stealing") {
+                scheduler_ = make_unique<ActorScheduler>(num);
+            }
+
+            if (worker["quota"]) {
+                quota_ = worker["quota"].as<size_t>();
+            }
+
+            // CPU cores which the worker threads bind to
+            if (worker["affinity"] && worker["affinity"].IsSequence()) {
+                for (const auto &core : worker["affinity"]) {
+                    cores_.emplace_back(core.as<int>());
+                }
+            }
+
+            // Migration of the pinned actors between workers
+            if (const auto &migrate = worker["migrate"]; migrate && migrate.IsMap()) {
+                if (migrate["interval"]) {
+                    migrateInterval = std::chrono::seconds(migrate["interval"].as<int>());
+                }
+                if (migrate["ratio"]) {
+                    migrateRatio = migrate["ratio"].as<double>();
+                }
+                if (migrate["backlog"]) {
+                    migrateBacklog = migrate["backlog"].as<size_t>();
+                }
+            }
+        }
+
+        // One tick shard per worker thread for each tick period
+        tickService_ = make_unique<TickService>(getWorkerExecutor(), num);
+        timerService_ = make_unique<TimerService>(getWorkerExecutor(), num);
+
+        for (const auto &val : ordered_) {
+            SPDLOG_INFO("Start module: {}", val->getModuleName());
+            val->start();
         }
 
-        pool_.start(num);
-        SPDLOG_INFO("Worker pool start with {} thread(s)", num);
+        if (scheduler_) {
+            scheduler_->start(cores_);
+            SPDLOG_INFO("Work-stealing scheduler start with {} thread(s)", num);
+
+            if (migrateInterval > SteadyDuration::zero()) {
+                asio::co_spawn(ctx_, rebalance(migrateInterval, migrateRatio, migrateBacklog), asio::detached);
+            }
+        } else {
+            pool_.start(num, cores_);
+            SPDLOG_INFO("Worker pool start with {} thread(s)", num);
+        }
 
         asio::signal_set signals(ctx_, SIGINT, SIGTERM);
         signals.async_wait([this](auto, auto) {
@@ -58,9 +109,23 @@ namespace uranus {
         if (ctx_.stopped())
             return;
 
+        if (tickService_) {
+            tickService_->stop();
+        }
+
+        if (timerService_) {
+            timerService_->stop();
+        }
+
+        rebalancer_.cancel();
+
         // Shutdown the workers pool
         pool_.stop();
 
+        if (scheduler_) {
+            scheduler_->stop();
+        }
+
         // Shutdown all modules
         for (const auto val : ordered_ | std::views::reverse) {
             SPDLOG_INFO("Stop module: {}", val->getModuleName());
@@ -89,6 +154,50 @@ namespace uranus {
         return pool_.getIOContext();
     }
 
+    asio::any_io_executor GameWorld::getWorkerExecutor() {
+        if (scheduler_)
+            return scheduler_->get_executor();
+
+        return pool_.getIOContext().get_executor();
+    }
+
+    asio::any_io_executor GameWorld::getPinnedExecutor(const size_t key) {
+        // 每个固定的Actor拥有自己的Placement, 负载不均时可以被迁移
+        if (scheduler_)
+            return scheduler_->get_executor(scheduler_->createPlacement(key % scheduler_->size()));
+
+        return pool_.getIOContext().get_executor();
+    }
+
+    bool GameWorld::isPinningSupported() const {
+        return scheduler_ != nullptr;
+    }
+
+    TickService *GameWorld::getTickService() const {
+        return tickService_.get();
+    }
+
+    TimerService *GameWorld::getTimerService() const {
+        return timerService_.get();
+    }
+
+    size_t GameWorld::getWorkerQuota() const {
+        return scheduler_ ? quota_ : 0;
+    }
+
+    asio::awaitable<void> GameWorld::rebalance(const SteadyDuration interval, const double ratio, const size_t backlog) {
+        while (isRunning()) {
+            rebalancer_.expires_after(interval);
+            if (const auto [ec] = co_await rebalancer_.async_wait(); ec)
+                break;
+
+            if (!scheduler_)
+                break;
+
+            scheduler_->rebalance(ratio, backlog);
+        }
+    }
+
     // void GameWorld::pushModule(ServerModule *module) {
     //     if (!module)
     //         return;
@@ -1,7 +1,11 @@
 #pragma once
 
 #include <base/SingleIOContextPool.h>
+#include <base/types.h>
 #include <actor/ServerModule.h>
+#include <actor/scheduler/ActorScheduler.h>
+#include <actor/timer/TickService.h>
+#include <actor/timer/TimerService.h>
 
 #include <memory>
 #include <vector>
@@ -15,6 +19,9 @@ namespace uranus {
     using std::unordered_map;
 
     using actor::ServerModule;
+    using actor::ActorScheduler;
+    using actor::TickService;
+    using actor::TimerService;
 
     class GameWorld final {
 
@@ -32,17 +39,45 @@ namespace uranus {
         asio::io_context &getIOContext();
         asio::io_context &getWorkerIOContext();
 
+        /// Actor使用的执行器, 根据server.worker.scheduler选择共享io_context或工作窃取调度器
+        asio::any_io_executor getWorkerExecutor();
+
+        /// 固定在key对应工作线程上的执行器, 仅工作窃取调度器支持, 否则退化为getWorkerExecutor()
+        asio::any_io_executor getPinnedExecutor(size_t key);
+
+        [[nodiscard]] bool isPinningSupported() const;
+
+        /// 工作窃取调度器下每个Actor单次调度处理的信封数量, 0表示使用Actor自身配置
+        [[nodiscard]] size_t getWorkerQuota() const;
+
+        /// 所有Actor共享的Tick服务, 在模块启动前创建
+        [[nodiscard]] TickService *getTickService() const;
+
+        /// 所有Actor共享的时间轮, 每个工作线程一个分片
+        [[nodiscard]] TimerService *getTimerService() const;
+
         template<typename T, typename... Args>
         requires std::derived_from<T, ServerModule>
         void pushModule(Args &&...args);
 
         [[nodiscard]] ServerModule *getModule(const std::string &name) const;
 
+    private:
+        /// 定期检查工作线程负载, 把固定在繁忙线程上的Actor迁移到空闲线程
+        asio::awaitable<void> rebalance(SteadyDuration interval, double ratio, size_t backlog);
+
     private:
         asio::io_context ctx_;
         asio::executor_work_guard<asio::io_context::executor_type> guard_;
+        SteadyTimer rebalancer_;
 
         SingleIOContextPool pool_;
+        unique_ptr<ActorScheduler> scheduler_;
+        unique_ptr<TickService> tickService_;
+        unique_ptr<TimerService> timerService_;
+
+        size_t quota_;
+        vector<int> cores_;
 
         unordered_map<std::string, unique_ptr<ServerModule>> modules_;
         vector<ServerModule *> ordered_;
@@ -74,7 +74,7 @@ namespace uranus {
             return;
 
         // Dispatch event in the main thread
-        asio::post(world_.getIOContext(), [this, evt, data = std::move(data)] {
+        asio::post(world_.getIOContext(), [this, evt, data = actor::SharedDataAsset(std::move(data))] {
             if (!world_.isRunning())
                 return;
 
@@ -86,21 +86,21 @@ namespace uranus {
                 set = it->second;
             }
 
+            // 所有监听者共享同一份只读数据, 需要修改的监听者在默认的onEvent中得到自己的副本
+            if (data == nullptr)
+                return;
+
             if (const auto *mgr = GET_MODULE(&world_, ServiceManager)) {
                 for (const auto &ctx: mgr->getServiceSet(set.services)) {
-                    if (data != nullptr) {
-                        auto evl = Envelope::makeDataAsset(evt, DataAssetHandle(data->clone()));
-                        ctx->pushEnvelope(std::move(evl));
-                    }
+                    auto evl = Envelope::makeSharedEvent(evt, data);
+                    ctx->pushEnvelope(std::move(evl));
                 }
             }
 
             if (const auto *mgr = GET_MODULE(&world_, PlayerManager)) {
                 for (const auto &plr: mgr->getPlayerSet(set.players)) {
-                    if (data != nullptr) {
-                        auto evl = Envelope::makeDataAsset(evt, DataAssetHandle(data->clone()));
-                        plr->pushEnvelope(std::move(evl));
-                    }
+                    auto evl = Envelope::makeSharedEvent(evt, data);
+                    plr->pushEnvelope(std::move(evl));
                 }
             }
         });
@@ -16,7 +16,10 @@ namespace uranus {
 
     ClientConnection::ClientConnection(TcpSocket &&socket)
         : ConnectionAdapter(std::move(socket)),
-          gateway_(nullptr) {
+          gateway_(nullptr),
+          framing_(PackageCodec::Framing::kFixed),
+          compression_(false),
+          negotiatePending_(false) {
     }
 
     ClientConnection::~ClientConnection() = default;
@@ -31,6 +34,22 @@ namespace uranus {
         return nullptr;
     }
 
+    void ClientConnection::setFraming(const PackageCodec::Framing framing) {
+        framing_.store(framing, std::memory_order_release);
+    }
+
+    PackageCodec::Framing ClientConnection::getFraming() const {
+        return framing_.load(std::memory_order_acquire);
+    }
+
+    void ClientConnection::setCompression(const bool enable) {
+        compression_.store(enable, std::memory_order_release);
+    }
+
+    bool ClientConnection::getCompression() const {
+        return compression_.load(std::memory_order_acquire);
+    }
+
     void ClientConnection::onConnect() {
     }
 
@@ -67,6 +86,13 @@ namespace uranus {
             return;
         }
 
+        // 客户端以旧格式发送的最后一帧, 之后的帧(包括已在读缓冲区中的)按协商的格式解析
+        if (pkg->getId() == login::kLoginAck) {
+            codec().setReadFraming(getFraming());
+            codec().setReadCompression(getCompression());
+            return;
+        }
+
         // Waiting database data
         if (const auto db_op = attr().get<bool>("WAITING_DB");
             db_op.has_value() && db_op.value() == true)
@@ -76,16 +102,33 @@ namespace uranus {
         const auto pid = op.value();
 
         if (const auto *mgr = GET_MODULE(getWorld(), PlayerManager)) {
-            if (const auto plr = mgr->find(pid)) {
+            if (auto *plr = mgr->borrow(pid)) {
                 constexpr int type = Package::kFromClient | Package::kToPlayer;
                 auto evl = Envelope::makePackage(type, pid, std::move(pkg));
 
                 plr->pushEnvelope(std::move(evl));
+
+                // 玩家Actor处理不过来 暂停读取直到邮箱降到低水位
+                if (plr->checkCongestion()) {
+                    SPDLOG_DEBUG("Player[{}] mailbox congested, pause reading", pid);
+                    pauseRead();
+                }
             }
         }
     }
 
     void ClientConnection::beforeWrite(Package *pkg) {
+        // 登录成功的回包仍使用默认格式, 之后的消息才使用协商的格式
+        if (negotiatePending_) {
+            codec().setWriteFraming(getFraming());
+            codec().setWriteCompression(getCompression());
+            negotiatePending_ = false;
+        }
+
+        // 读取格式等客户端的LoginAck再切换, 见onReadMessage()
+        if (pkg->getId() == login::kLoginSuccess) {
+            negotiatePending_ = true;
+        }
     }
 
     void ClientConnection::afterWrite(PackageHandle &&pkg) {
@@ -3,6 +3,8 @@
 #include <network/ConnectionAdapter.h>
 #include <actor/PackageCodec.h>
 
+#include <atomic>
+
 
 namespace uranus {
 
@@ -25,6 +27,14 @@ namespace uranus {
         [[nodiscard]] Gateway *getGateway() const;
         [[nodiscard]] GameWorld *getWorld() const;
 
+        /// 登录时协商的帧格式, 写入在登录成功的回包之后生效, 读取在收到客户端的LoginAck之后生效; 广播按该格式选择共享的帧
+        void setFraming(PackageCodec::Framing framing);
+        [[nodiscard]] PackageCodec::Framing getFraming() const;
+
+        /// 登录时协商的载荷压缩, 与帧格式同时生效; 广播的帧不压缩
+        void setCompression(bool enable);
+        [[nodiscard]] bool getCompression() const;
+
     protected:
         void onConnect() override;
         void onDisconnect() override;
@@ -44,5 +54,11 @@ namespace uranus {
 
     private:
         Gateway *gateway_;
+
+        std::atomic<PackageCodec::Framing> framing_;
+        std::atomic_bool compression_;
+
+        /// 只在写循环中访问, 登录成功的回包已编码, 下一条消息切换写入格式
+        bool negotiatePending_;
     };
 }
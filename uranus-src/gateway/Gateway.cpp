@@ -8,18 +8,42 @@
 
 #include <yaml-cpp/yaml.h>
 #include <spdlog/spdlog.h>
+#include <array>
 
 
 namespace uranus {
 
     using config::ConfigModule;
+    using actor::PackageCodec;
+    using network::WireBuffer;
+
+    /// 按连接的帧格式取共享的帧, 每种格式第一次用到时编码
+    static const WireBuffer &SerializeFor(std::array<WireBuffer, 2> &wires, const ClientConnection &conn, const actor::Package &pkg) {
+        const auto framing = conn.getFraming();
+        auto &wire = wires[static_cast<size_t>(framing)];
+
+        if (wire == nullptr) {
+            wire = PackageCodec::serialize(pkg, framing);
+        }
+
+        return wire;
+    }
 
     Gateway::Gateway(GameWorld &world)
-        : world_(world) {
+        : world_(world),
+          coalesceMessages_(0),
+          coalesceBytes_(0),
+          maxFrameSize_(PackageCodec::kDefaultMaxFrameSize),
+          compact_(false),
+          compression_(false),
+          compressionOptions_{ 512, 1, 15 } {
         SPDLOG_DEBUG("Gateway created");
     }
 
     Gateway::~Gateway() {
+        conns_.clear();
+        conns_.purge();
+
         SPDLOG_DEBUG("Gateway destroyed");
     }
 
@@ -35,6 +59,29 @@ namespace uranus {
         const auto port = cfg["server"]["network"]["port"].as<uint16_t>();
         const auto threads = cfg["server"]["network"]["threads"].as<int>();
 
+        if (const auto &coalesce = cfg["server"]["network"]["coalesce"]; coalesce && coalesce.IsMap()) {
+            coalesceMessages_ = coalesce["messages"] ? coalesce["messages"].as<size_t>() : 0;
+            coalesceBytes_ = coalesce["bytes"] ? coalesce["bytes"].as<size_t>() : 65536;
+        }
+
+        if (cfg["server"]["network"]["max_frame"]) {
+            maxFrameSize_ = cfg["server"]["network"]["max_frame"].as<size_t>();
+        }
+
+        if (cfg["server"]["network"]["compact"]) {
+            compact_ = cfg["server"]["network"]["compact"].as<bool>();
+        }
+
+        if (const auto &compression = cfg["server"]["network"]["compression"]; compression && compression.IsMap()) {
+            compression_ = compression["enable"] && compression["enable"].as<bool>();
+            if (compression["threshold"])
+                compressionOptions_.threshold = compression["threshold"].as<size_t>();
+            if (compression["level"])
+                compressionOptions_.level = compression["level"].as<int>();
+            if (compression["window"])
+                compressionOptions_.window = compression["window"].as<int>();
+        }
+
         bootstrap_ = std::make_unique<ServerBootstrap>(threads);
 
 #ifdef URANUS_SSL
@@ -50,6 +97,12 @@ namespace uranus {
 
             conn->setGateway(this);
             conn->setExpirationSecond(30);
+            conn->setWriteCoalescing(coalesceMessages_, coalesceBytes_);
+            conn->codec().setMaxFrameSize(maxFrameSize_);
+
+            if (compression_) {
+                conn->codec().setCompressionOptions(compressionOptions_);
+            }
 
             spdlog::info("Accept client from: {}", conn->remoteAddress().to_string());
 
@@ -65,6 +118,17 @@ namespace uranus {
         });
 
         SPDLOG_INFO("Use IO Threads: {}", threads);
+        SPDLOG_INFO("Max frame size: {} bytes", maxFrameSize_);
+        if (coalesceMessages_ > 1) {
+            SPDLOG_INFO("Write coalescing: {} messages, {} bytes", coalesceMessages_, coalesceBytes_);
+        }
+        if (compact_) {
+            SPDLOG_INFO("Compact framing enabled");
+        }
+        if (compression_) {
+            SPDLOG_INFO("Payload compression: threshold {} bytes, level {}, window {}",
+                compressionOptions_.threshold, compressionOptions_.level, compressionOptions_.window);
+        }
         SPDLOG_INFO("Listening on port: {}", port);
 
         bootstrap_->run(port);
@@ -87,18 +151,26 @@ namespace uranus {
         if (!world_.isRunning())
             return;
 
-        shared_ptr<ClientConnection> old;
+        // 客户端请求紧凑格式且服务器允许时启用
+        auto framing = PackageCodec::Framing::kFixed;
+        if (const auto op = conn->attr().get<int64_t>("FRAMING");
+            compact_ && op.has_value() && op.value() == static_cast<int64_t>(PackageCodec::Framing::kCompact)) {
+            framing = PackageCodec::Framing::kCompact;
+        }
 
-        do {
-            unique_lock lock(mutex_);
+        const auto compression = compression_ && conn->attr().get<bool>("COMPRESSION").value_or(false);
 
-            if (const auto it = conns_.find(pid); it != conns_.end()) {
-                old = it->second;
-                conns_.insert_or_assign(it, pid, conn);
-            } else {
-                conns_.insert_or_assign(pid, conn);
-            }
-        } while (false);
+        conn->setFraming(framing);
+        conn->setCompression(compression);
+
+        SPDLOG_INFO("Player[{}] login from: {}", pid, conn->remoteAddress().to_string());
+        conn->attr().set("PLAYER_ID", pid);
+        conn->attr().set("WAITING_DB", true);
+
+        login::LoginAuth::sendLoginSuccess(conn, pid, static_cast<uint32_t>(framing), compression);
+
+        // 登录成功的回包入队之后才加入连接表, 广播的帧不会排在回包之前
+        const auto old = conns_.insert_or_assign(pid, conn);
 
         // Send a repeated message and disconnect the old
         if (old) {
@@ -112,12 +184,6 @@ namespace uranus {
             });
         }
 
-        SPDLOG_INFO("Player[{}] login from: {}", pid, conn->remoteAddress().to_string());
-        conn->attr().set("PLAYER_ID", pid);
-        conn->attr().set("WAITING_DB", true);
-
-        login::LoginAuth::sendLoginSuccess(conn, pid);
-
         if (auto *mgr = GET_MODULE(&world_, PlayerManager)) {
             mgr->onPlayerLogin(pid, conn);
         }
@@ -127,10 +193,7 @@ namespace uranus {
         if (!world_.isRunning())
             return;
 
-        {
-            unique_lock lock(mutex_);
-            conns_.erase(pid);
-        }
+        conns_.erase(pid);
 
         if (auto *mgr = GET_MODULE(&world_, PlayerManager)) {
             mgr->onPlayerLogout(pid);
@@ -144,8 +207,54 @@ namespace uranus {
         if (!world_.isRunning())
             return nullptr;
 
-        shared_lock lock(mutex_);
-        const auto it = conns_.find(pid);
-        return it != conns_.end() ? it->second : nullptr;
+        const auto *conn = conns_.find(pid);
+        return conn != nullptr ? *conn : nullptr;
+    }
+
+    ClientConnection *Gateway::borrow(const int64_t pid) const {
+        if (bootstrap_ == nullptr)
+            return nullptr;
+
+        if (!world_.isRunning())
+            return nullptr;
+
+        const auto *conn = conns_.find(pid);
+        return conn != nullptr ? conn->get() : nullptr;
+    }
+
+    void Gateway::broadcast(const std::set<int64_t> &pids, PackageHandle &&pkg) const {
+        if (pkg == nullptr || pids.empty())
+            return;
+
+        if (bootstrap_ == nullptr || !world_.isRunning())
+            return;
+
+        std::array<WireBuffer, 2> wires;
+
+        for (const auto pid : pids) {
+            if (const auto *conn = conns_.find(pid)) {
+                (*conn)->sendWire(SerializeFor(wires, **conn, *pkg));
+            }
+        }
+    }
+
+    void Gateway::broadcast(PackageHandle &&pkg) const {
+        this->broadcast([](int64_t) { return true; }, std::move(pkg));
+    }
+
+    void Gateway::broadcast(const std::function<bool(int64_t)> &pred, PackageHandle &&pkg) const {
+        if (pkg == nullptr)
+            return;
+
+        if (bootstrap_ == nullptr || !world_.isRunning())
+            return;
+
+        std::array<WireBuffer, 2> wires;
+
+        conns_.forEach([&pred, &wires, &pkg](const int64_t pid, const shared_ptr<ClientConnection> &conn) {
+            if (std::invoke(pred, pid)) {
+                conn->sendWire(SerializeFor(wires, *conn, *pkg));
+            }
+        });
     }
 }
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <base/SnapshotMap.h>
 #include <actor/ServerModule.h>
+#include <actor/Package.h>
+#include <actor/PackageCodec.h>
 #include <network/ServerBootstrap.h>
 
-#include <unordered_map>
-#include <shared_mutex>
 #include <asio/co_spawn.hpp>
+#include <functional>
+#include <set>
 #include <asio/detached.hpp>
 
 
@@ -18,12 +21,9 @@ namespace uranus {
     using std::unique_ptr;
     using std::make_unique;
     using std::make_shared;
-    using std::shared_mutex;
-    using std::unique_lock;
-    using std::shared_lock;
-    using std::unordered_map;
 
     using actor::ServerModule;
+    using actor::PackageHandle;
     using network::ServerBootstrap;
 
     class GameWorld;
@@ -46,16 +46,42 @@ namespace uranus {
         [[nodiscard]] GameWorld &getWorld() const;
 
         void emplace(int64_t pid, const shared_ptr<ClientConnection> &conn);
+        /// 与PlayerManager::onPlayerLogout()相同, 被移除的ClientConnection可能仍由空闲线程的本地快照持有,
+        /// 直到该线程在同一分片上再次查询或stop()时purge(); 连接需要自己关闭socket, 不能等析构
         void remove(int64_t pid);
 
         [[nodiscard]] shared_ptr<ClientConnection> find(int64_t pid) const;
 
+        /// 不加锁也不增加引用计数, 只用于拿到后立即发送.
+        /// 指针由当前线程缓存的分片快照持有, 当前线程在同一分片上的下一次查询(find/borrow)可能刷新快照并使其失效;
+        /// 不要保存, 也不要在持有期间再次查询或挂起协程, 需要跨越这些点时使用find()
+        [[nodiscard]] ClientConnection *borrow(int64_t pid) const;
+
+        /// 每种帧格式只编码一次, 相同格式的目标连接共享同一份帧数据
+        void broadcast(const std::set<int64_t> &pids, PackageHandle &&pkg) const;
+        void broadcast(PackageHandle &&pkg) const;
+        void broadcast(const std::function<bool(int64_t)> &pred, PackageHandle &&pkg) const;
+
     private:
         GameWorld &world_;
 
         unique_ptr<ServerBootstrap> bootstrap_;
 
-        mutable shared_mutex mutex_;
-        unordered_map<int64_t, shared_ptr<ClientConnection>> conns_;
+        /// 每个连接的合并写入上限
+        size_t coalesceMessages_;
+        size_t coalesceBytes_;
+
+        /// 客户端单个包的最大载荷长度
+        size_t maxFrameSize_;
+
+        /// 是否接受客户端请求的紧凑帧格式
+        bool compact_;
+
+        /// 是否接受客户端请求的载荷压缩, 及每个连接的压缩参数
+        bool compression_;
+        actor::PackageCodec::CompressionOptions compressionOptions_;
+
+        /// 按玩家id分片, 查询不加锁
+        SnapshotMap<int64_t, shared_ptr<ClientConnection>> conns_;
     };
 }
\ No newline at end of file
@@ -1,7 +1,12 @@
 #include "WorldMonitor.h"
+#include "GameWorld.h"
 
+#include <config/ConfigModule.h>
+#include <yaml-cpp/yaml.h>
 #include <spdlog/spdlog.h>
 
+using uranus::config::ConfigModule;
+
 namespace uranus {
     WorldMonitor::WorldMonitor(GameWorld &world)
         : world_(world) {
@@ -13,8 +18,31 @@ namespace uranus {
     }
 
     void WorldMonitor::start() {
+        const auto *config = GET_MODULE(&world_, ConfigModule);
+        if (!config)
+            return;
+
+        const auto &monitor = config->getServerConfig()["server"]["monitor"];
+        if (!monitor || !monitor.IsMap())
+            return;
+
+        // 单次处理的预算(毫秒), 0表示不启用
+        const auto budget = monitor["watchdog"] ? monitor["watchdog"].as<int>() : 0;
+        if (budget <= 0)
+            return;
+
+        const auto backtrace = monitor["backtrace"] && monitor["backtrace"].as<bool>();
+
+        watchdog_ = std::make_unique<Watchdog>(std::chrono::milliseconds(budget), backtrace);
+        watchdog_->start();
+
+        SPDLOG_INFO("Watchdog started, budget: {} ms, backtrace: {}", budget, backtrace);
     }
 
     void WorldMonitor::stop() {
+        if (watchdog_) {
+            watchdog_->stop();
+            watchdog_.reset();
+        }
     }
 } // uranus
@@ -1,10 +1,13 @@
 #pragma once
 
 #include <actor/ServerModule.h>
+#include <actor/scheduler/Watchdog.h>
+#include <memory>
 
 namespace uranus {
 
     using actor::ServerModule;
+    using actor::Watchdog;
 
     class GameWorld;
 
@@ -24,5 +27,8 @@ namespace uranus {
 
     private:
         GameWorld &world_;
+
+        /// 检测阻塞工作线程的慢处理
+        std::unique_ptr<Watchdog> watchdog_;
     };
 } // uranus
@@ -9,6 +9,7 @@
 #include "monitor/WorldMonitor.h"
 
 #include <asio/bind_allocator.hpp>
+#include <asio/post.hpp>
 
 #include "actor/BaseActor.h"
 
@@ -34,7 +35,7 @@ namespace uranus {
         // 发送至Service
         if ((ty & Package::kToService) != 0) {
             if (const auto *mgr = GET_MODULE(getWorld(), ServiceManager)) {
-                if (const auto ser = mgr->find(target)) {
+                if (auto *ser = mgr->borrow(target)) {
                     auto evl = Envelope::makePackage((Package::kFromPlayer | ty), pid, std::move(pkg));
                     ser->pushEnvelope(std::move(evl));
                 }
@@ -42,10 +43,50 @@ namespace uranus {
         }
         // 发送给客户端
         else if ((ty & Package::kToClient) != 0) {
-            if (const auto *gateway = GET_MODULE(getWorld(), Gateway)) {
-                if (const auto client = gateway->find(pid)) {
-                    client->send(std::move(pkg));
-                    return;
+            if (const auto client = getClient()) {
+                client->send(std::move(pkg));
+            }
+        }
+    }
+
+    ActorRef PlayerContext::resolve(const int ty, const int64_t target) const {
+        // 玩家只能直接发送给Service
+        if ((ty & Package::kToService) == 0)
+            return {};
+
+        if (const auto *mgr = GET_MODULE(getWorld(), ServiceManager)) {
+            if (const auto ser = mgr->find(target)) {
+                return { Package::kToService, target, ser };
+            }
+        }
+
+        return {};
+    }
+
+    void PlayerContext::send(const ActorRef &ref, PackageHandle &&pkg) {
+        const auto pid = getPlayerId();
+        if (pid < 0 || ref.getType() != Package::kToService)
+            return;
+
+        // 只增加引用计数, 不加锁也不查表
+        if (const auto ser = ref.lock(); ser && ser->isRunning()) {
+            auto evl = Envelope::makePackage((Package::kFromPlayer | Package::kToService), pid, std::move(pkg));
+            ser->pushEnvelope(std::move(evl));
+        }
+    }
+
+    void PlayerContext::multicast(const int ty, const std::set<int64_t> &targets, PackageHandle &&pkg) {
+        const auto pid = getPlayerId();
+        if (pid < 0 || targets.empty())
+            return;
+
+        // 只能向Service多播
+        if ((ty & Package::kToService) != 0) {
+            if (const auto *mgr = GET_MODULE(getWorld(), ServiceManager)) {
+                const auto shared = actor::MakeSharedPackage(std::move(pkg));
+                for (const auto &ser: mgr->getServiceSet(targets)) {
+                    auto evl = Envelope::makeMulticast((Package::kFromPlayer | ty), pid, shared);
+                    ser->pushEnvelope(std::move(evl));
                 }
             }
         }
@@ -62,6 +103,20 @@ namespace uranus {
         return nullptr;
     }
 
+    TickService *PlayerContext::getTickService() const {
+        if (const auto *world = getWorld()) {
+            return world->getTickService();
+        }
+        return nullptr;
+    }
+
+    TimerService *PlayerContext::getTimerService() const {
+        if (const auto *world = getWorld()) {
+            return world->getTimerService();
+        }
+        return nullptr;
+    }
+
     ServerModule *PlayerContext::getModule(const std::string &name) const {
         if (manager_ && manager_->getModuleName() == name)
             return manager_;
@@ -98,16 +153,21 @@ namespace uranus {
 
     void PlayerContext::setPlayerId(const int64_t pid) {
         attr().set("PLAYER_ID", pid);
+        setActorId(pid);
     }
 
     int64_t PlayerContext::getPlayerId() const {
-        if (const auto op = attr().get<int64_t>("PLAYER_ID"); op.has_value()) {
-            return op.value();
-        }
-        return -1;
+        // 缓存的id, 发送路径上不再查询AttributeMap
+        return getActorId();
     }
 
-    void PlayerContext::sendRequest(const int ty, const int64_t sess, const int64_t target, PackageHandle &&pkg) {
+    void PlayerContext::sendRequest(
+        const int ty,
+        const int64_t sess,
+        const int64_t target,
+        PackageHandle &&pkg,
+        const SteadyTimePoint deadline
+    ) {
         if (!isRunning())
             return;
 
@@ -118,8 +178,8 @@ namespace uranus {
         // 只能向Service异步请求
         if ((ty & Package::kToService) != 0) {
             if (const auto *mgr = GET_MODULE(getWorld(), ServiceManager)) {
-                if (const auto ctx = mgr->find(target)) {
-                    auto evl = Envelope::makeRequest((ty | Package::kFromPlayer), pid, sess, std::move(pkg));
+                if (auto *ctx = mgr->borrow(target)) {
+                    auto evl = Envelope::makeRequest((ty | Package::kFromPlayer), pid, sess, std::move(pkg), deadline);
                     ctx->pushEnvelope(std::move(evl));
                 }
             }
@@ -137,7 +197,7 @@ namespace uranus {
         // 只接受来自Service的异步请求
         if ((ty & Package::kToService) != 0) {
             if (const auto *mgr = GET_MODULE(getWorld(), ServiceManager)) {
-                if (const auto ctx = mgr->find(target)) {
+                if (auto *ctx = mgr->borrow(target)) {
                     auto evl = Envelope::makeResponse((ty | Package::kFromPlayer), pid, sess, std::move(pkg));
                     ctx->pushEnvelope(std::move(evl));
                 }
@@ -209,6 +269,36 @@ namespace uranus {
         lDispatchResult(std::move(handler), nullptr);
     }
 
+    void PlayerContext::onMailboxRelieved() {
+        if (const auto client = getClient()) {
+            client->resumeRead();
+        }
+    }
+
+    void PlayerContext::bindClient(const std::shared_ptr<ClientConnection> &conn) {
+        asio::post(executor(), [self = shared_from_this(), weak = std::weak_ptr(conn)]() mutable {
+            static_cast<PlayerContext *>(self.get())->client_ = std::move(weak);
+        });
+    }
+
+    std::shared_ptr<ClientConnection> PlayerContext::getClient() {
+        if (auto client = client_.lock())
+            return client;
+
+        const auto pid = getPlayerId();
+        if (pid < 0)
+            return nullptr;
+
+        if (const auto *gateway = GET_MODULE(getWorld(), Gateway)) {
+            if (auto client = gateway->find(pid)) {
+                client_ = client;
+                return client;
+            }
+        }
+
+        return nullptr;
+    }
+
     void PlayerContext::setPlayerManager(PlayerManager *mgr) {
         if (!isInitial())
             return;
@@ -10,10 +10,14 @@ namespace uranus {
     using actor::PackageHandle;
     using actor::DataAssetHandle;
     using actor::ActorMap;
+    using actor::ActorRef;
     using actor::CommandHandler;
+    using actor::TickService;
+    using actor::TimerService;
 
     class PlayerManager;
     class GameWorld;
+    class ClientConnection;
 
     class PlayerContext final : public BaseActorContext {
 
@@ -30,7 +34,12 @@ namespace uranus {
 
         [[nodiscard]] ServerModule *getModule(const std::string &name) const override;
 
+        [[nodiscard]] ActorRef resolve(int ty, int64_t target) const override;
+        using super::resolve;
+
         void send(int ty, int64_t target, PackageHandle &&pkg) override;
+        void send(const ActorRef &ref, PackageHandle &&pkg) override;
+        void multicast(int ty, const std::set<int64_t> &targets, PackageHandle &&pkg) override;
 
         void dispatch(int64_t evt, DataAssetHandle &&data) override;
         void listen(int64_t evt, bool cancel) override;
@@ -41,18 +50,32 @@ namespace uranus {
         void setPlayerId(int64_t pid);
         [[nodiscard]] int64_t getPlayerId() const;
 
+        /// 绑定当前的客户端连接, 发往客户端的消息不再经过Gateway查询
+        void bindClient(const std::shared_ptr<ClientConnection> &conn);
+
     protected:
-        void sendRequest(int ty, int64_t sess, int64_t target, PackageHandle &&pkg) override;
+        void sendRequest(int ty, int64_t sess, int64_t target, PackageHandle &&pkg, SteadyTimePoint deadline) override;
         void sendResponse(int ty, int64_t sess, int64_t target, PackageHandle &&pkg) override;
 
         void createCommand(const std::string &cmd, DataAssetHandle &&data, CommandHandler &&handler) override;
 
+        void onMailboxRelieved() override;
+
         bool cleanUp() override;
 
+        [[nodiscard]] TickService *getTickService() const override;
+        [[nodiscard]] TimerService *getTimerService() const override;
+
     private:
         void setPlayerManager(PlayerManager *mgr);
 
+        /// 只在Actor执行器上调用, 未绑定或连接已释放时回退到Gateway查询
+        std::shared_ptr<ClientConnection> getClient();
+
     private:
         PlayerManager *manager_;
+
+        /// 只在Actor执行器上访问
+        std::weak_ptr<ClientConnection> client_;
     };
 } // uranus
@@ -8,23 +8,29 @@
 #include <actor/BasePlayer.h>
 #include <login/data_asset/DA_PlayerResult.h>
 #include <database/DatabaseModule.h>
+#include <config/ConfigModule.h>
 #include <login/LoginAuth.h>
+#include <yaml-cpp/yaml.h>
 #include <spdlog/spdlog.h>
+#include <algorithm>
 
 
 namespace uranus {
 
     using actor::BaseActor;
     using database::DatabaseModule;
+    using config::ConfigModule;
     using login::DA_PlayerResult;
 
     PlayerManager::PlayerManager(GameWorld &world)
-        : world_(world) {
+        : world_(world),
+          pinned_(false) {
         SPDLOG_DEBUG("PlayerManager created");
     }
 
     PlayerManager::~PlayerManager() {
         players_.clear();
+        players_.purge();
 
         SPDLOG_DEBUG("PlayerManager destroyed");
     }
@@ -36,6 +42,18 @@ namespace uranus {
     void PlayerManager::start() {
         // Initial the player manager
         PLAYER_FACTORY.initial();
+
+        if (const auto *config = GET_MODULE(&world_, ConfigModule)) {
+            const auto &cfg = config->getServerConfig();
+            if (cfg["server"]["player"] && cfg["server"]["player"]["pinned"]) {
+                pinned_ = cfg["server"]["player"]["pinned"].as<bool>();
+            }
+        }
+
+        if (pinned_ && !world_.isPinningSupported()) {
+            SPDLOG_WARN("Player pinning requires the stealing scheduler, ignored");
+            pinned_ = false;
+        }
     }
 
     void PlayerManager::stop() {
@@ -50,6 +68,8 @@ namespace uranus {
 
         // Maybe login repeated
         if (const auto plr = find(pid); plr) {
+            plr->bindClient(client);
+
             client->attr().erase("WAITING_DB");
             login::LoginAuth::sendLoginProcessInfo(client, pid, "Reconnect to player actor");
             SPDLOG_WARN("Player[{}] already exists!", pid);
@@ -73,24 +93,20 @@ namespace uranus {
             delete ptr;
         });
 
-        auto strand = asio::make_strand(world_.getWorkerIOContext());
-        auto ctx = std::make_shared<PlayerContext>(strand, std::move(handle));
-        SPDLOG_INFO("Player[{}] context created", pid);
+        auto strand = pinned_
+            ? asio::make_strand(world_.getPinnedExecutor(std::hash<int64_t>{}(pid)))
+            : asio::make_strand(world_.getWorkerExecutor());
 
-        // In normal, that would not get the repeated one
-        shared_ptr<PlayerContext> old;
+        auto ctx = std::make_shared<PlayerContext>(strand, std::move(handle));
 
-        {
-            unique_lock lock(mutex_);
+        if (const auto quota = world_.getWorkerQuota(); quota > ctx->getQuota()) {
+            ctx->setQuota(quota);
+        }
 
-            // If the same player id actor has exists
-            if (const auto it = players_.find(pid); it != players_.end()) {
-                old = it->second;
-                players_.erase(it);
-            }
+        SPDLOG_INFO("Player[{}] context created", pid);
 
-            players_.insert_or_assign(pid, ctx);
-        }
+        // In normal, that would not get the repeated one
+        const auto old = players_.insert_or_assign(pid, ctx);
 
         // Stop the old one
         if (old) {
@@ -98,9 +114,10 @@ namespace uranus {
             old->terminate();
         }
 
-        ctx->attr().set("PLAYER_ID", pid);
+        ctx->setPlayerId(pid);
         ctx->attr().set("LIBRARY_PATH", path.string());
         ctx->setPlayerManager(this);
+        ctx->bindClient(client);
 
         SPDLOG_INFO("Add player[{}] to PlayerManager", pid);
 
@@ -146,18 +163,7 @@ namespace uranus {
         if (!world_.isRunning())
             return;
 
-        shared_ptr<PlayerContext> ctx;
-
-        {
-            unique_lock lock(mutex_);
-
-            if (const auto it = players_.find(pid); it != players_.end()) {
-                ctx = it->second;
-                players_.erase(it);
-            }
-        }
-
-        if (ctx) {
+        if (const auto ctx = players_.erase(pid)) {
             SPDLOG_INFO("Remove player[{}]", pid);
             ctx->terminate();
         }
@@ -167,9 +173,16 @@ namespace uranus {
         if (!world_.isRunning())
             return nullptr;
 
-        shared_lock lock(mutex_);
-        const auto it = players_.find(pid);
-        return it != players_.end() ? it->second : nullptr;
+        const auto *plr = players_.find(pid);
+        return plr != nullptr ? *plr : nullptr;
+    }
+
+    PlayerContext *PlayerManager::borrow(const int64_t pid) const {
+        if (!world_.isRunning())
+            return nullptr;
+
+        const auto *plr = players_.find(pid);
+        return plr != nullptr ? plr->get() : nullptr;
     }
 
     set<shared_ptr<PlayerContext>> PlayerManager::getPlayerSet(const set<int64_t> &pids) const {
@@ -177,14 +190,33 @@ namespace uranus {
             return {};
 
         set<shared_ptr<PlayerContext>> result;
-        shared_lock lock(mutex_);
 
         for (const auto pid : pids) {
-            if (const auto it = players_.find(pid); it != players_.end()) {
-                result.insert(it->second);
+            if (const auto *plr = players_.find(pid)) {
+                result.insert(*plr);
             }
         }
 
         return result;
     }
+
+    ActorStatsRank PlayerManager::getTopN(const size_t num, const bool reset) const {
+        ActorStatsRank result;
+
+        result.reserve(players_.size());
+        players_.forEach([&result, reset](const int64_t id, const shared_ptr<PlayerContext> &ctx) {
+            result.emplace_back(id, ctx->getStats().snapshot());
+            if (reset) {
+                ctx->getStats().reset();
+            }
+        });
+
+        const auto count = std::min(num, result.size());
+        std::ranges::partial_sort(result, result.begin() + static_cast<ptrdiff_t>(count), std::greater{}, [](const auto &node) {
+            return node.second.totalHandleTime();
+        });
+
+        result.resize(count);
+        return result;
+    }
 } // uranus
@@ -1,19 +1,16 @@
 #pragma once
 
+#include <base/SnapshotMap.h>
 #include <actor/ServerModule.h>
+#include <actor/ActorStats.h>
 
-#include <shared_mutex>
-#include <unordered_map>
 #include <set>
 
 namespace uranus {
 
     using actor::ServerModule;
-    using std::unordered_map;
+    using actor::ActorStatsRank;
     using std::shared_ptr;
-    using std::shared_mutex;
-    using std::unique_lock;
-    using std::shared_lock;
     using std::set;
 
     class GameWorld;
@@ -36,16 +33,29 @@ namespace uranus {
 
         void onPlayerLogin(int64_t pid, const shared_ptr<ClientConnection> &client);
         void onPlayerData(int64_t pid, const std::string &str) const;
+        /// 从表中移除并终止上下文.
+        /// 其他线程缓存的分片快照仍引用被移除的PlayerContext, 直到该线程在同一分片上再次查询, 或stop()时purge();
+        /// 空闲的线程可能长时间持有, 因此析构的时机不确定, 不要依赖析构释放外部资源
         void onPlayerLogout(int64_t pid);
 
         [[nodiscard]] shared_ptr<PlayerContext> find(int64_t pid) const;
 
+        /// 不加锁也不增加引用计数, 只用于拿到后立即投递.
+        /// 指针由当前线程缓存的分片快照持有, 当前线程在同一分片上的下一次查询(find/borrow)可能刷新快照并使其失效;
+        /// 不要保存, 也不要在持有期间再次查询或挂起协程, 需要跨越这些点时使用find()
+        [[nodiscard]] PlayerContext *borrow(int64_t pid) const;
+
         [[nodiscard]] set<shared_ptr<PlayerContext>> getPlayerSet(const set<int64_t> &pids) const;
 
+        /// 按处理耗时从高到低返回前num个玩家, reset为true时同时清零, 开始新的统计窗口
+        [[nodiscard]] ActorStatsRank getTopN(size_t num, bool reset = false) const;
+
     private:
         GameWorld &world_;
 
-        mutable shared_mutex mutex_;
-        unordered_map<int64_t, shared_ptr<PlayerContext>> players_;
+        /// 按玩家id哈希固定工作线程
+        bool pinned_;
+
+        SnapshotMap<int64_t, shared_ptr<PlayerContext>> players_;
     };
 } // uranus
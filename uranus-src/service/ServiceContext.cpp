@@ -42,7 +42,7 @@ namespace uranus {
             if (target == sid)
                 return;
 
-            if (const auto dest = manager_->find(target)) {
+            if (auto *dest = manager_->borrow(target)) {
                 auto evl = Envelope::makePackage((Package::kFromService | ty), sid, std::move(pkg));
                 dest->pushEnvelope(std::move(evl));
             }
@@ -50,7 +50,7 @@ namespace uranus {
         // 发送至Player
         else if ((ty & Package::kToPlayer) != 0) {
             if (const auto *mgr = GET_MODULE(getWorld(), PlayerManager)) {
-                if (const auto plr = mgr->find(target)) {
+                if (auto *plr = mgr->borrow(target)) {
                     auto evl = Envelope::makePackage((Package::kFromService | ty), sid, std::move(pkg));
                     plr->pushEnvelope(std::move(evl));
                 }
@@ -59,13 +59,89 @@ namespace uranus {
         // 直接发送给客户端
         else if ((ty & Package::kToClient) != 0) {
             if (const auto *gateway = GET_MODULE(getWorld(), Gateway)) {
-                if (const auto client = gateway->find(target)) {
+                if (auto *client = gateway->borrow(target)) {
                     client->send(std::move(pkg));
                 }
             }
         }
     }
 
+    ActorRef ServiceContext::resolve(const int ty, const int64_t target) const {
+        if ((ty & Package::kToService) != 0) {
+            if (target == getServiceId())
+                return {};
+
+            if (const auto dest = manager_->find(target)) {
+                return { Package::kToService, target, dest };
+            }
+        }
+        else if ((ty & Package::kToPlayer) != 0) {
+            if (const auto *mgr = GET_MODULE(getWorld(), PlayerManager)) {
+                if (const auto plr = mgr->find(target)) {
+                    return { Package::kToPlayer, target, plr };
+                }
+            }
+        }
+
+        return {};
+    }
+
+    void ServiceContext::send(const ActorRef &ref, PackageHandle &&pkg) {
+        if (!isRunning())
+            return;
+
+        const auto sid = getServiceId();
+        if (sid < 0)
+            return;
+
+        if (ref.getType() != Package::kToService && ref.getType() != Package::kToPlayer)
+            return;
+
+        // 只增加引用计数, 不加锁也不查表
+        if (const auto dest = ref.lock(); dest && dest.get() != this && dest->isRunning()) {
+            auto evl = Envelope::makePackage((Package::kFromService | ref.getType()), sid, std::move(pkg));
+            dest->pushEnvelope(std::move(evl));
+        }
+    }
+
+    void ServiceContext::multicast(const int ty, const std::set<int64_t> &targets, PackageHandle &&pkg) {
+        if (!isRunning() || targets.empty())
+            return;
+
+        const auto sid = getServiceId();
+        if (sid < 0)
+            return;
+
+        // 发往客户端时只编码一次
+        if ((ty & Package::kToClient) != 0) {
+            if (const auto *gateway = GET_MODULE(getWorld(), Gateway)) {
+                gateway->broadcast(targets, std::move(pkg));
+            }
+            return;
+        }
+
+        // 载荷只在这里共享一次, 所有目标的邮箱持有同一份只读数据
+        const auto shared = actor::MakeSharedPackage(std::move(pkg));
+
+        if ((ty & Package::kToService) != 0) {
+            for (const auto &dest: manager_->getServiceSet(targets)) {
+                if (dest.get() == this)
+                    continue;
+
+                auto evl = Envelope::makeMulticast((Package::kFromService | ty), sid, shared);
+                dest->pushEnvelope(std::move(evl));
+            }
+        }
+        else if ((ty & Package::kToPlayer) != 0) {
+            if (const auto *mgr = GET_MODULE(getWorld(), PlayerManager)) {
+                for (const auto &plr: mgr->getPlayerSet(targets)) {
+                    auto evl = Envelope::makeMulticast((Package::kFromService | ty), sid, shared);
+                    plr->pushEnvelope(std::move(evl));
+                }
+            }
+        }
+    }
+
     ServiceManager *ServiceContext::getServiceManager() const {
         return manager_;
     }
@@ -77,6 +153,20 @@ namespace uranus {
         return nullptr;
     }
 
+    TickService *ServiceContext::getTickService() const {
+        if (const auto *world = getWorld()) {
+            return world->getTickService();
+        }
+        return nullptr;
+    }
+
+    TimerService *ServiceContext::getTimerService() const {
+        if (const auto *world = getWorld()) {
+            return world->getTimerService();
+        }
+        return nullptr;
+    }
+
     ServerModule *ServiceContext::getModule(const std::string &name) const {
         if (manager_ && manager_->getModuleName() == name)
             return manager_;
@@ -114,16 +204,21 @@ namespace uranus {
 
     void ServiceContext::setServiceId(int64_t sid) {
         attr().set("SERVICE_ID", sid);
+        setActorId(sid);
     }
 
     int64_t ServiceContext::getServiceId() const {
-        if (const auto op = attr().get<int>("SERVICE_ID"); op.has_value()) {
-            return op.value();
-        }
-        return -1;
+        // 缓存的id, 发送路径上不再查询AttributeMap
+        return getActorId();
     }
 
-    void ServiceContext::sendRequest(const int ty, const int64_t sess, const int64_t target, PackageHandle &&pkg) {
+    void ServiceContext::sendRequest(
+        const int ty,
+        const int64_t sess,
+        const int64_t target,
+        PackageHandle &&pkg,
+        const SteadyTimePoint deadline
+    ) {
         if (!isRunning())
             return;
 
@@ -135,8 +230,8 @@ namespace uranus {
             if (target == sid)
                 return;
 
-            if (const auto dest = manager_->find(target)) {
-                auto evl = Envelope::makeRequest((Package::kFromService | ty), sid, sess, std::move(pkg));
+            if (auto *dest = manager_->borrow(target)) {
+                auto evl = Envelope::makeRequest((Package::kFromService | ty), sid, sess, std::move(pkg), deadline);
                 dest->pushEnvelope(std::move(evl));
                 return;
             }
@@ -144,8 +239,8 @@ namespace uranus {
 
         if ((ty & Package::kToPlayer) != 0) {
             if (const auto *mgr = GET_MODULE(getWorld(), PlayerManager)) {
-                if (const auto plr = mgr->find(target)) {
-                    auto evl = Envelope::makeRequest((Package::kFromService | ty), sid, sess, std::move(pkg));
+                if (auto *plr = mgr->borrow(target)) {
+                    auto evl = Envelope::makeRequest((Package::kFromService | ty), sid, sess, std::move(pkg), deadline);
                     plr->pushEnvelope(std::move(evl));
                     return;
                 }
@@ -165,7 +260,7 @@ namespace uranus {
             if (target == sid)
                 return;
 
-            if (const auto dest = manager_->find(target)) {
+            if (auto *dest = manager_->borrow(target)) {
                 auto evl = Envelope::makeResponse((Package::kFromService | ty), sid, sess, std::move(pkg));
                 dest->pushEnvelope(std::move(evl));
             }
@@ -173,7 +268,7 @@ namespace uranus {
 
         if ((ty & Package::kToPlayer) != 0) {
             if (const auto *mgr = GET_MODULE(getWorld(), PlayerManager)) {
-                if (const auto plr = mgr->find(target)) {
+                if (auto *plr = mgr->borrow(target)) {
                     auto evl = Envelope::makeResponse((Package::kFromService | ty), sid, sess, std::move(pkg));
                     plr->pushEnvelope(std::move(evl));
                 }
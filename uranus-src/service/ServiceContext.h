@@ -15,8 +15,11 @@ namespace uranus {
     using actor::PackageHandle;
     using actor::DataAssetHandle;
     using actor::ActorMap;
+    using actor::ActorRef;
     using actor::ServerModule;
     using actor::CommandHandler;
+    using actor::TickService;
+    using actor::TimerService;
 
     class ServiceManager;
     class GameWorld;
@@ -33,7 +36,12 @@ namespace uranus {
 
         [[nodiscard]] BaseService *getService() const;
 
+        [[nodiscard]] ActorRef resolve(int ty, int64_t target) const override;
+        using super::resolve;
+
         void send(int ty, int64_t target, PackageHandle &&pkg) override;
+        void send(const ActorRef &ref, PackageHandle &&pkg) override;
+        void multicast(int ty, const std::set<int64_t> &targets, PackageHandle &&pkg) override;
 
         void dispatch(int64_t evt, DataAssetHandle &&data) override;
         void listen(int64_t evt, bool cancel) override;
@@ -50,13 +58,16 @@ namespace uranus {
         [[nodiscard]] int64_t getServiceId() const;
 
     protected:
-        void sendRequest(int ty, int64_t sess, int64_t target, PackageHandle &&pkg) override;
+        void sendRequest(int ty, int64_t sess, int64_t target, PackageHandle &&pkg, SteadyTimePoint deadline) override;
         void sendResponse(int ty, int64_t sess, int64_t target, PackageHandle &&pkg) override;
 
         void createCommand(const std::string &cmd, DataAssetHandle &&data, CommandHandler &&handler) override;
 
         bool cleanUp() override;
 
+        [[nodiscard]] TickService *getTickService() const override;
+        [[nodiscard]] TimerService *getTimerService() const override;
+
     private:
         void setServiceManager(ServiceManager *mgr);
 
@@ -7,6 +7,7 @@
 #include <config/ConfigModule.h>
 #include <yaml-cpp/yaml.h>
 #include <spdlog/spdlog.h>
+#include <algorithm>
 
 
 namespace uranus {
@@ -34,6 +35,12 @@ namespace uranus {
 
         const auto &cfg = config->getServerConfig();
 
+        // Services which are bound to the specified worker thread
+        const auto &pinned = cfg["server"]["service"]["pinned"];
+        if (pinned && pinned.size() > 0 && !world_.isPinningSupported()) {
+            SPDLOG_WARN("Service pinning requires the stealing scheduler, ignored");
+        }
+
         for (const auto &item : cfg["server"]["service"]["core"]) {
             const auto filename = item.as<std::string>();
             const auto real_name = std::string("core.") + filename;
@@ -57,10 +64,17 @@ namespace uranus {
                 delete ptr;
             });
 
-            auto strand = asio::make_strand(world_.getWorkerIOContext());
+            auto strand = (pinned && pinned[filename])
+                ? asio::make_strand(world_.getPinnedExecutor(pinned[filename].as<size_t>()))
+                : asio::make_strand(world_.getWorkerExecutor());
+
             const auto ctx = std::make_shared<ServiceContext>(strand, std::move(handle));
 
-            ctx->attr().set("SERVICE_ID", sid);
+            if (const auto quota = world_.getWorkerQuota(); quota > ctx->getQuota()) {
+                ctx->setQuota(quota);
+            }
+
+            ctx->setServiceId(sid);
             ctx->attr().set("LIBRARY_PATH", path.string());
             ctx->setServiceManager(this);
 
@@ -68,21 +82,21 @@ namespace uranus {
             SPDLOG_INFO("Created service[{} - {}]", sid, filename);
         }
 
-        for (const auto &[sid, ctx] : services_) {
+        services_.forEach([this](const int64_t sid, const shared_ptr<ServiceContext> &ctx) {
             ctx->run(nullptr);
 
             const auto name = ctx->getService()->getName();
             SPDLOG_INFO("Started service [{} - {}]", sid, name);
 
             nameToId_[name] = sid;
-        }
+        });
     }
 
     void ServiceManager::stop() {
-        for (const auto &[sid, ctx] : services_) {
+        services_.forEach([](const int64_t sid, const shared_ptr<ServiceContext> &ctx) {
             ctx->terminate();
             SPDLOG_INFO("Stopped service [{} - {}]", sid, ctx->getService()->getName());
-        }
+        });
     }
 
     GameWorld &ServiceManager::getWorld() const {
@@ -93,9 +107,16 @@ namespace uranus {
         if (!world_.isRunning())
             return nullptr;
 
-        shared_lock lock(mutex_);
-        const auto iter = services_.find(sid);
-        return iter == services_.end() ? nullptr : iter->second;
+        const auto *ser = services_.find(sid);
+        return ser != nullptr ? *ser : nullptr;
+    }
+
+    ServiceContext *ServiceManager::borrow(const int64_t sid) const {
+        if (!world_.isRunning())
+            return nullptr;
+
+        const auto *ser = services_.find(sid);
+        return ser != nullptr ? ser->get() : nullptr;
     }
 
     set<shared_ptr<ServiceContext>> ServiceManager::getServiceSet(const set<int64_t> &sids) const {
@@ -103,17 +124,36 @@ namespace uranus {
             return {};
 
         set<shared_ptr<ServiceContext>> result;
-        shared_lock lock(mutex_);
 
         for (const auto sid : sids) {
-            if (const auto it = services_.find(sid); it != services_.end()) {
-                result.insert(it->second);
+            if (const auto *ser = services_.find(sid)) {
+                result.insert(*ser);
             }
         }
 
         return result;
     }
 
+    ActorStatsRank ServiceManager::getTopN(const size_t num, const bool reset) const {
+        ActorStatsRank result;
+
+        result.reserve(services_.size());
+        services_.forEach([&result, reset](const int64_t id, const shared_ptr<ServiceContext> &ctx) {
+            result.emplace_back(id, ctx->getStats().snapshot());
+            if (reset) {
+                ctx->getStats().reset();
+            }
+        });
+
+        const auto count = std::min(num, result.size());
+        std::ranges::partial_sort(result, result.begin() + static_cast<ptrdiff_t>(count), std::greater{}, [](const auto &node) {
+            return node.second.totalHandleTime();
+        });
+
+        result.resize(count);
+        return result;
+    }
+
     ServiceMap ServiceManager::getServiceMap() const {
         if (!world_.isRunning())
             return {};
@@ -144,9 +184,8 @@ namespace uranus {
         unique_lock cacheLock(cacheMutex_);
         nameToId_.clear();
 
-        shared_lock lock(mutex_);
-        for (const auto &[key, val] : services_) {
+        services_.forEach([this](const int64_t key, const shared_ptr<ServiceContext> &val) {
             nameToId_[val->getService()->getName()] = key;
-        }
+        });
     }
 } // uranus
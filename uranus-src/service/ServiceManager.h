@@ -1,7 +1,9 @@
 #pragma once
 
 #include <base/IdentAllocator.h>
+#include <base/SnapshotMap.h>
 #include <actor/ServerModule.h>
+#include <actor/ActorStats.h>
 
 #include <shared_mutex>
 #include <unordered_map>
@@ -13,6 +15,7 @@
 namespace uranus {
 
     using actor::ServerModule;
+    using actor::ActorStatsRank;
     using std::unordered_map;
     using std::map;
     using std::set;
@@ -41,8 +44,16 @@ namespace uranus {
         [[nodiscard]] GameWorld &getWorld() const;
 
         [[nodiscard]] shared_ptr<ServiceContext> find(int64_t sid) const;
+
+        /// 不加锁也不增加引用计数, 只用于拿到后立即投递.
+        /// 指针由当前线程缓存的分片快照持有, 当前线程在同一分片上的下一次查询(find/borrow)可能刷新快照并使其失效;
+        /// 不要保存, 也不要在持有期间再次查询或挂起协程, 需要跨越这些点时使用find()
+        [[nodiscard]] ServiceContext *borrow(int64_t sid) const;
         [[nodiscard]] set<shared_ptr<ServiceContext>> getServiceSet(const set<int64_t> &sids) const;
 
+        /// 按处理耗时从高到低返回前num个服务, reset为true时同时清零, 开始新的统计窗口
+        [[nodiscard]] ActorStatsRank getTopN(size_t num, bool reset = false) const;
+
         [[nodiscard]] ServiceMap getServiceMap() const;
         [[nodiscard]] int64_t queryServiceId(const std::string &name) const;
 
@@ -54,8 +65,7 @@ namespace uranus {
 
         IdentAllocator<int64_t, true> idAlloc_;
 
-        mutable shared_mutex mutex_;
-        unordered_map<int64_t, shared_ptr<ServiceContext>> services_;
+        SnapshotMap<int64_t, shared_ptr<ServiceContext>> services_;
 
         ServiceHashMap nameToId_;
         mutable shared_mutex cacheMutex_;